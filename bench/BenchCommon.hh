@@ -0,0 +1,318 @@
+#ifndef BenchCommon_h
+#define BenchCommon_h
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "G4Step.hh"
+#include "G4UserSteppingAction.hh"
+#include "OutputSink.hh"
+#include "PixelGeometry.hh"
+#include "TFile.h"
+#include "TTree.h"
+#include "TVector3.h"
+
+namespace Bench {
+
+/// Wall clock in seconds
+inline double now() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Run the job in a forked process and return its result.
+/// The Geant4 kernel, particles and physics tables can be set up
+/// only once per process, so the physics variants run isolated
+template <typename T>
+std::optional<T> runIsolated(const std::function<T()>& job) {
+  static_assert(std::is_trivially_copyable_v<T>);
+
+  int fds[2];
+  if (pipe(fds) != 0) {
+    return std::nullopt;
+  }
+  pid_t pid = fork();
+  if (pid < 0) {
+    close(fds[0]);
+    close(fds[1]);
+    return std::nullopt;
+  }
+  if (pid == 0) {
+    close(fds[0]);
+    T result = job();
+    bool ok = write(fds[1], &result, sizeof(T)) == sizeof(T);
+    close(fds[1]);
+    std::_Exit(ok ? 0 : 1);
+  }
+
+  close(fds[1]);
+  T result;
+  bool ok = read(fds[0], &result, sizeof(T)) == sizeof(T);
+  close(fds[0]);
+  int status;
+  waitpid(pid, &status, 0);
+  if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+    return std::nullopt;
+  }
+  return result;
+}
+
+/// Counts the steps of all tracks
+class StepCounter : public G4UserSteppingAction {
+ public:
+  void UserSteppingAction(const G4Step*) override { m_steps++; }
+
+  std::uint64_t steps() const { return m_steps; }
+  void reset() { m_steps = 0; }
+
+ private:
+  std::uint64_t m_steps = 0;
+};
+
+/// Pixel level summary of one sensor
+struct LayerSummary {
+  std::uint64_t pixels = 0;
+  double eDep = 0;
+  double x = 0;
+  double y = 0;
+};
+
+/// Summarize the Run output per geometry id
+inline std::map<int, LayerSummary> summarizeLayers(
+    const std::string& filePath, const std::string& treeName) {
+  std::map<int, LayerSummary> layers;
+
+  TFile file(filePath.c_str(), "READ");
+  auto* tree = file.Get<TTree>(treeName.c_str());
+  if (tree == nullptr) {
+    return layers;
+  }
+
+  int geoId;
+  double totEDep;
+  TVector3* geoCenterGlobal = nullptr;
+  tree->SetBranchAddress("geoId", &geoId);
+  tree->SetBranchAddress("totEDep", &totEDep);
+  tree->SetBranchAddress("geoCenterGlobal", &geoCenterGlobal);
+
+  for (Long64_t i = 0; i < tree->GetEntries(); i++) {
+    tree->GetEntry(i);
+    LayerSummary& layer = layers[geoId];
+    layer.pixels++;
+    layer.eDep += totEDep;
+    layer.x += geoCenterGlobal->X();
+    layer.y += geoCenterGlobal->Y();
+  }
+  for (auto& [id, layer] : layers) {
+    layer.eDep /= layer.pixels;
+    layer.x /= layer.pixels;
+    layer.y /= layer.pixels;
+  }
+  return layers;
+}
+
+/// Pixel i of synthetic events with pixelsPerEvent pixels, shaped
+/// like the Run output: the event, its primary and the primary track
+/// are fixed within the event, the pixels are clusters on the ALPIDE
+/// grid of six chips around the track of the event and the ids are
+/// small integers. A pixel has the hit of the primary and a few of
+/// its secondaries; the values are in the units of Run
+inline void syntheticRecord(std::mt19937& rng, std::uint64_t i,
+                            PixelRecord& r,
+                            std::uint64_t pixelsPerEvent = 16) {
+  std::uniform_real_distribution<double> uniform(0, 1);
+  std::uniform_int_distribution<int> clusterOffset(-2, 2);
+  std::normal_distribution<double> normal;
+  std::geometric_distribution<int> extraHits(0.4);
+  const double electronMass = 0.51099895;
+  const int nChips = 6;
+
+  // The event values depend only on the event
+  std::uint64_t event = i / pixelsPerEvent;
+  std::mt19937 eventRng(static_cast<std::uint32_t>(event));
+  double primaryE = 1000 * (1 + uniform(eventRng));
+  double primaryTheta = 0.035 * uniform(eventRng);
+  double primaryPhi = 2 * M_PI * uniform(eventRng);
+  TVector3 primaryDir;
+  primaryDir.SetMagThetaPhi(1, primaryTheta, primaryPhi);
+  TVector3 primaryVertex(uniform(eventRng) - 0.5, uniform(eventRng) - 0.5,
+                         0);
+  int trackX = static_cast<int>(eventRng() % PixelGeometry::nPixelsX);
+  int trackY = static_cast<int>(eventRng() % PixelGeometry::nPixelsY);
+
+  r.eventId = static_cast<int>(event);
+  r.runId = 0;
+  r.eventWeight = 1;
+  r.primaryE.assign(1, primaryE);
+  r.primaryTheta.assign(1, primaryTheta);
+  r.primaryPhi.assign(1, primaryPhi);
+  r.primaryWeight.assign(1, 1);
+
+  // Pixel k of the event is on chip k % nChips, near the track
+  std::uint64_t k = i % pixelsPerEvent;
+  r.geoId = static_cast<int>(k % nChips);
+  r.pixIdX = (trackX + clusterOffset(rng) + PixelGeometry::nPixelsX) %
+             PixelGeometry::nPixelsX;
+  r.pixIdY = (trackY + clusterOffset(rng) + PixelGeometry::nPixelsY) %
+             PixelGeometry::nPixelsY;
+  G4TwoVector center = PixelGeometry::pixelCenter(r.pixIdX, r.pixIdY);
+  r.geoCenterLocal.Set(center.x(), center.y());
+  r.geoCenterGlobal.SetXYZ(center.x(), center.y(), 1000 + 10 * r.geoId);
+
+  std::size_t nHits = 1 + extraHits(rng);
+  r.parentTrackId.resize(nHits);
+  r.trackId.resize(nHits);
+  r.primaryIdx.assign(nHits, 0);
+  r.hitPosGlobal.resize(nHits);
+  r.hitPosLocal.resize(nHits);
+  r.hitEntryPosGlobal.resize(nHits);
+  r.hitMomDir.resize(nHits);
+  r.hitE.resize(nHits);
+  r.hitP.resize(nHits);
+  r.ipMomDir.resize(nHits);
+  r.ipE.resize(nHits);
+  r.ipP.resize(nHits);
+  r.vertex.resize(nHits);
+  r.eDep.resize(nHits);
+  r.pdgId.resize(nHits);
+  r.hitPrimaryE.assign(nHits, primaryE);
+  r.hitPrimaryTheta.assign(nHits, primaryTheta);
+  r.hitPrimaryPhi.assign(nHits, primaryPhi);
+  r.hitPrimaryWeight.assign(nHits, 1);
+  r.totEDep = 0;
+  for (std::size_t j = 0; j < nHits; j++) {
+    bool primary = j == 0;
+    r.parentTrackId[j] = primary ? 0 : 1;
+    r.trackId[j] = primary ? 1 : 2 + static_cast<int>(rng() % 8);
+    r.pdgId[j] = primary || uniform(rng) < 0.8 ? 11 : 22;
+    // In the pixel, as the compact offsets assume
+    r.hitPosLocal[j].Set(
+        center.x() + (uniform(rng) - 0.5) * PixelGeometry::pixelX,
+        center.y() + (uniform(rng) - 0.5) * PixelGeometry::pixelY);
+    r.hitPosGlobal[j].SetXYZ(r.hitPosLocal[j].X(), r.hitPosLocal[j].Y(),
+                             r.geoCenterGlobal.Z());
+    // The primary scatters little, the secondaries are spread wide
+    double sigma = primary ? 0.01 : 0.5;
+    r.hitMomDir[j] = primaryDir + TVector3(sigma * normal(rng),
+                                           sigma * normal(rng), 0);
+    r.hitMomDir[j] = r.hitMomDir[j].Unit();
+    // Half the 50 um thickness of the chip upstream
+    r.hitEntryPosGlobal[j] = r.hitPosGlobal[j] - 0.025 * r.hitMomDir[j];
+    r.hitE[j] = primary ? primaryE - 0.1 * r.geoId : 1 + uniform(rng);
+    double mass = r.pdgId[j] == 11 ? electronMass : 0;
+    r.hitP[j] = std::sqrt(r.hitE[j] * r.hitE[j] - mass * mass);
+    // The secondaries start in the chip
+    r.ipMomDir[j] = primary ? primaryDir : r.hitMomDir[j];
+    r.ipE[j] = primary ? primaryE : r.hitE[j];
+    r.ipP[j] = primary ? std::sqrt(primaryE * primaryE -
+                                   electronMass * electronMass)
+                       : r.hitP[j];
+    r.vertex[j] = primary ? primaryVertex : r.hitEntryPosGlobal[j];
+    r.eDep[j] = (primary ? 0.01 : 0.002) * (0.5 + uniform(rng));
+    r.totEDep += r.eDep[j];
+  }
+  // As in Run, the last hit of the pixel decides
+  r.isSignal = r.pdgId.back() == 11 && r.trackId.back() == 1 &&
+               r.parentTrackId.back() == 0;
+}
+
+/// Writes nPixels synthetic records through the sinks of nThreads
+/// threads, each its share; returns the seconds including the close.
+/// An event split between two threads ends twice
+inline double writeSynthetic(const OutputSink::Config& cfg,
+                             const std::string& filePath,
+                             const std::string& treeName,
+                             std::uint64_t nPixels, int nThreads,
+                             std::uint64_t pixelsPerEvent = 16) {
+  auto write = [&](std::uint64_t first, std::uint64_t last) {
+    PixelRecord record;
+    auto sink = OutputSink::create(cfg, filePath, treeName, record);
+    std::mt19937 rng(first);
+    for (std::uint64_t i = first; i < last; i++) {
+      syntheticRecord(rng, i, record, pixelsPerEvent);
+      sink->write();
+      if ((i + 1) % pixelsPerEvent == 0 || i + 1 == last) {
+        sink->endEvent();
+      }
+    }
+    sink->close({});
+  };
+  double start = now();
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nThreads; t++) {
+    workers.emplace_back(write, nPixels * t / nThreads,
+                         nPixels * (t + 1) / nThreads);
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  return now() - start;
+}
+
+struct ReadResult {
+  double seconds;
+  std::uint64_t pixels;
+  std::uint64_t hits;
+};
+
+/// Reads all branches of the Run tree, in either precision, or
+/// only the geoId, totEDep and hitE of a typical analysis. The
+/// branches without an address are read into buffers of ROOT
+inline ReadResult readTree(const std::string& filePath,
+                           const std::string& treeName, bool allFields) {
+  ReadResult result{};
+  double start = now();
+  TFile file(filePath.c_str(), "READ");
+  auto* tree = file.Get<TTree>(treeName.c_str());
+  if (tree == nullptr) {
+    return result;
+  }
+
+  int geoId;
+  double totEDep;
+  std::vector<double>* hitE = nullptr;
+  if (!allFields) {
+    tree->SetBranchStatus("*", false);
+    tree->SetBranchStatus("geoId", true);
+    tree->SetBranchStatus("totEDep", true);
+    tree->SetBranchStatus("hitE", true);
+  }
+  tree->SetBranchAddress("geoId", &geoId);
+  tree->SetBranchAddress("totEDep", &totEDep);
+  tree->SetBranchAddress("hitE", &hitE);
+
+  for (Long64_t i = 0; i < tree->GetEntries(); i++) {
+    tree->GetEntry(i);
+    result.pixels++;
+    result.hits += hitE->size();
+  }
+  result.seconds = now() - start;
+  return result;
+}
+
+/// Size of the file, 0 if it does not exist
+inline std::uint64_t fileBytes(const std::string& filePath) {
+  std::error_code ec;
+  std::uint64_t bytes = std::filesystem::file_size(filePath, ec);
+  return ec ? 0 : bytes;
+}
+
+}  // namespace Bench
+
+#endif
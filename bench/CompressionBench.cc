@@ -0,0 +1,145 @@
+// Output tree settings matrix: every ROOT compression algorithm at a
+// fast and a strong level, two basket sizes and two AutoFlush
+// policies, on the same synthetic pixel records, and the LZ4 and
+// ZSTD defaults with the compact precision of RootSink. Reports the write
+// throughput, the file size and the read throughput of all branches
+// and of the three of a typical analysis, from the page cache. LZ4
+// is the candidate for scratch runs, ZSTD and LZMA for the archive.
+// The results are printed as a table and written as JSON.
+//
+// Usage: alWindowCompressionBench [nPixels] [outDir] [result.json|-]
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "OutputSink.hh"
+
+struct Setting {
+  std::string compression;
+  int basketBytes;
+  std::int64_t autoFlush;
+  bool compactPrecision;
+};
+
+struct SettingResult {
+  double writeSeconds;
+  std::uint64_t fileBytes;
+  double readAllSeconds;
+  double readSomeSeconds;
+};
+
+namespace {
+
+const char* treeName = "particles";
+
+std::string autoFlushName(std::int64_t autoFlush) {
+  return autoFlush < 0 ? std::to_string(-autoFlush / 1000000) + " MB"
+                       : std::to_string(autoFlush) + " entries";
+}
+
+void writeJson(std::FILE* out, std::uint64_t nPixels,
+               const std::vector<Setting>& settings,
+               const std::vector<SettingResult>& results) {
+  std::fprintf(out, "{\n  \"benchmark\": \"alWindowCompressionBench\",\n");
+  std::fprintf(out, "  \"nPixels\": %llu,\n  \"settings\": [",
+               static_cast<unsigned long long>(nPixels));
+  for (std::size_t i = 0; i < settings.size(); i++) {
+    const Setting& setting = settings[i];
+    const SettingResult& result = results[i];
+    std::fprintf(out,
+                 "%s\n    {\"compression\": \"%s\", \"basketBytes\": %d, "
+                 "\"autoFlush\": %lld, \"compactPrecision\": %s, "
+                 "\"writePixelsPerSecond\": %.6g, \"fileBytes\": %llu, "
+                 "\"readAllPixelsPerSecond\": %.6g, "
+                 "\"readSomePixelsPerSecond\": %.6g}",
+                 i == 0 ? "" : ",", setting.compression.c_str(),
+                 setting.basketBytes,
+                 static_cast<long long>(setting.autoFlush),
+                 setting.compactPrecision ? "true" : "false",
+                 nPixels / result.writeSeconds,
+                 static_cast<unsigned long long>(result.fileBytes),
+                 nPixels / result.readAllSeconds,
+                 nPixels / result.readSomeSeconds);
+  }
+  std::fprintf(out, "\n  ]\n}\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::uint64_t nPixels = argc > 1 ? std::stoull(argv[1]) : 200000;
+  std::string outDir = argc > 2 ? argv[2] : ".";
+  std::string jsonPath = argc > 3 ? argv[3] : "-";
+
+  std::vector<Setting> settings;
+  for (const char* compression :
+       {"none", "zlib:1", "lz4:1", "lz4:4", "zstd:1", "zstd:5", "zstd:9",
+        "lzma:7"}) {
+    for (int basketBytes : {32000, 256000}) {
+      for (std::int64_t autoFlush : {-30000000LL, -5000000LL}) {
+        settings.push_back({compression, basketBytes, autoFlush, false});
+      }
+    }
+  }
+  for (const char* compression : {"lz4:4", "zstd:5"}) {
+    settings.push_back({compression, 32000, -30000000LL, true});
+  }
+
+  std::printf(
+      "\n%llu pixels\n%-8s %8s %10s %8s %12s %10s %7s %12s %12s\n",
+      static_cast<unsigned long long>(nPixels), "setting", "basket",
+      "autoFlush", "compact", "write [kpx/s]", "file [MB]", "ratio",
+      "all [kpx/s]", "3 [kpx/s]");
+  std::vector<SettingResult> results;
+  std::uint64_t uncompressedBytes = 0;
+  for (const Setting& setting : settings) {
+    OutputSink::Config cfg{
+        .format = OutputSink::Format::kRoot,
+        .compression = *OutputSink::compressionFromName(setting.compression),
+        .basketBytes = setting.basketBytes,
+        .autoFlush = setting.autoFlush,
+        .compactPrecision = setting.compactPrecision};
+    std::string filePath = outDir + "/compressionBench.root";
+
+    SettingResult result;
+    result.writeSeconds =
+        Bench::writeSynthetic(cfg, filePath, treeName, nPixels, 1);
+    result.fileBytes = Bench::fileBytes(filePath);
+    if (setting.compression == "none" && uncompressedBytes == 0) {
+      uncompressedBytes = result.fileBytes;
+    }
+    Bench::readTree(filePath, treeName, true);
+    result.readAllSeconds =
+        Bench::readTree(filePath, treeName, true).seconds;
+    Bench::readTree(filePath, treeName, false);
+    result.readSomeSeconds =
+        Bench::readTree(filePath, treeName, false).seconds;
+    results.push_back(result);
+
+    std::printf("%-8s %8d %10s %8s %12.1f %10.1f %7.2f %12.1f %12.1f\n",
+                setting.compression.c_str(), setting.basketBytes,
+                autoFlushName(setting.autoFlush).c_str(),
+                setting.compactPrecision ? "yes" : "no",
+                1e-3 * nPixels / result.writeSeconds, result.fileBytes / 1e6,
+                result.fileBytes > 0
+                    ? static_cast<double>(uncompressedBytes) / result.fileBytes
+                    : 0.0,
+                1e-3 * nPixels / result.readAllSeconds,
+                1e-3 * nPixels / result.readSomeSeconds);
+  }
+
+  std::printf("\n");
+  writeJson(stdout, nPixels, settings, results);
+  if (jsonPath != "-") {
+    std::FILE* file = std::fopen(jsonPath.c_str(), "w");
+    if (file == nullptr) {
+      std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+      return 1;
+    }
+    writeJson(file, nPixels, settings, results);
+    std::fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,132 @@
+// Pixel layout of the Run tree, one entry per fired pixel, against
+// the event layout of EventRootSink, one entry per event, on the same
+// synthetic records at several occupancies in pixels per event.
+// Reports the Fill calls, i.e. the entries of the tree, the write
+// throughput, the file size and the read throughput of all branches
+// from the page cache. The results are printed as a table and written
+// as JSON.
+//
+// Usage: alWindowEventLayoutBench [nPixels] [pixelsPerEvent,...]
+//                                 [outDir] [result.json|-]
+
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "OutputSink.hh"
+
+struct LayoutResult {
+  std::uint64_t pixelsPerEvent;
+  bool eventLayout;
+  std::uint64_t fills;
+  double writeSeconds;
+  std::uint64_t fileBytes;
+  double readSeconds;
+};
+
+namespace {
+
+const char* treeName = "particles";
+
+/// Reads every entry of the tree into buffers of ROOT, returns the
+/// seconds and the entries
+std::pair<double, std::uint64_t> readAll(const std::string& filePath) {
+  double start = Bench::now();
+  TFile file(filePath.c_str(), "READ");
+  auto* tree = file.Get<TTree>(treeName);
+  if (tree == nullptr) {
+    return {0, 0};
+  }
+  Long64_t nEntries = tree->GetEntries();
+  for (Long64_t i = 0; i < nEntries; i++) {
+    tree->GetEntry(i);
+  }
+  return {Bench::now() - start, static_cast<std::uint64_t>(nEntries)};
+}
+
+void writeJson(std::FILE* out, std::uint64_t nPixels,
+               const std::vector<LayoutResult>& results) {
+  std::fprintf(out, "{\n  \"benchmark\": \"alWindowEventLayoutBench\",\n");
+  std::fprintf(out, "  \"nPixels\": %llu,\n  \"results\": [",
+               static_cast<unsigned long long>(nPixels));
+  for (std::size_t i = 0; i < results.size(); i++) {
+    const LayoutResult& result = results[i];
+    std::fprintf(out,
+                 "%s\n    {\"pixelsPerEvent\": %llu, \"layout\": \"%s\", "
+                 "\"fills\": %llu, \"writePixelsPerSecond\": %.6g, "
+                 "\"fileBytes\": %llu, \"readPixelsPerSecond\": %.6g}",
+                 i == 0 ? "" : ",",
+                 static_cast<unsigned long long>(result.pixelsPerEvent),
+                 result.eventLayout ? "event" : "pixel",
+                 static_cast<unsigned long long>(result.fills),
+                 nPixels / result.writeSeconds,
+                 static_cast<unsigned long long>(result.fileBytes),
+                 nPixels / result.readSeconds);
+  }
+  std::fprintf(out, "\n  ]\n}\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::uint64_t nPixels = argc > 1 ? std::stoull(argv[1]) : 1000000;
+  std::string occupancyList = argc > 2 ? argv[2] : "1,16,256,4096";
+  std::string outDir = argc > 3 ? argv[3] : ".";
+  std::string jsonPath = argc > 4 ? argv[4] : "-";
+
+  std::vector<std::uint64_t> occupancies;
+  std::istringstream occupancyStream(occupancyList);
+  for (std::string occupancy; std::getline(occupancyStream, occupancy, ',');) {
+    occupancies.push_back(std::stoull(occupancy));
+  }
+
+  std::printf("\n%llu pixels\n%12s %7s %10s %14s %10s %12s %14s\n",
+              static_cast<unsigned long long>(nPixels), "pixels/event",
+              "layout", "Fill", "write [kpx/s]", "file [MB]", "[B/pixel]",
+              "read [kpx/s]");
+  std::vector<LayoutResult> results;
+  for (std::uint64_t pixelsPerEvent : occupancies) {
+    for (bool eventLayout : {false, true}) {
+      OutputSink::Format format = eventLayout
+                                      ? OutputSink::Format::kRootEvents
+                                      : OutputSink::Format::kRoot;
+      std::string filePath =
+          outDir + "/eventLayoutBench" + OutputSink::extension(format);
+
+      LayoutResult result{pixelsPerEvent, eventLayout};
+      result.writeSeconds = Bench::writeSynthetic(
+          {.format = format}, filePath, treeName, nPixels, 1,
+          pixelsPerEvent);
+      result.fileBytes = Bench::fileBytes(filePath);
+      readAll(filePath);
+      std::tie(result.readSeconds, result.fills) = readAll(filePath);
+      results.push_back(result);
+
+      std::printf("%12llu %7s %10llu %14.1f %10.1f %12.1f %14.1f\n",
+                  static_cast<unsigned long long>(pixelsPerEvent),
+                  eventLayout ? "event" : "pixel",
+                  static_cast<unsigned long long>(result.fills),
+                  1e-3 * nPixels / result.writeSeconds,
+                  result.fileBytes / 1e6,
+                  static_cast<double>(result.fileBytes) / nPixels,
+                  1e-3 * nPixels / result.readSeconds);
+    }
+  }
+
+  std::printf("\n");
+  writeJson(stdout, nPixels, results);
+  if (jsonPath != "-") {
+    std::FILE* file = std::fopen(jsonPath.c_str(), "w");
+    if (file == nullptr) {
+      std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+      return 1;
+    }
+    writeJson(file, nPixels, results);
+    std::fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,163 @@
+// Times the primary generation alone, without tracking: the
+// PrimarySampler engines on their own, Philox split over threads
+// by event id, and the full GeneratePrimaries into a G4Event. The
+// threaded Philox run must reproduce the single thread checksum.
+//
+// Usage: alWindowGenBench [nEvents] [particlesPerEvent] [nThreads]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "G4Electron.hh"
+#include "G4Event.hh"
+#include "G4SystemOfUnits.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "PrimarySampler.hh"
+
+struct GeneratorResult {
+  double seconds;
+  bool sampled;
+  double checksum;
+
+  // Moments of the angles, for a sanity check of the engines.
+  // Plain sums until runSampler normalises them
+  double thetaMean;
+  double thetaSigma;
+  double phiSigma;
+};
+
+/// Samples the events [first, last) and accumulates their moments
+void sampleEvents(PrimarySampler::Config cfg, std::uint64_t first,
+                  std::uint64_t last, std::size_t particlesPerEvent,
+                  GeneratorResult& result) {
+  PrimarySampler sampler(cfg);
+  PrimarySampler::Block block;
+  double theta = 0, theta2 = 0, phi2 = 0, checksum = 0;
+  for (std::uint64_t eventId = first; eventId < last; eventId++) {
+    sampler.sample(eventId, particlesPerEvent, block);
+    for (std::size_t i = 0; i < block.size(); i++) {
+      theta += block.theta[i];
+      theta2 += block.theta[i] * block.theta[i];
+      phi2 += block.phi[i] * block.phi[i];
+      checksum += block.energy[i] / GeV + block.theta[i] + block.phi[i];
+    }
+  }
+  result = {0, true, checksum, theta, theta2, phi2};
+}
+
+GeneratorResult runSampler(const PrimarySampler::Config& cfg,
+                           std::uint64_t nEvents,
+                           std::size_t particlesPerEvent, int nThreads) {
+  std::vector<GeneratorResult> parts(nThreads);
+  std::vector<std::thread> workers;
+  double start = Bench::now();
+  for (int t = 0; t < nThreads; t++) {
+    workers.emplace_back(sampleEvents, cfg, nEvents * t / nThreads,
+                         nEvents * (t + 1) / nThreads, particlesPerEvent,
+                         std::ref(parts[t]));
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  GeneratorResult result{Bench::now() - start, true, 0, 0, 0, 0};
+
+  // Equal for any thread count up to the rounding of the partial sums
+  double n = static_cast<double>(nEvents) * particlesPerEvent;
+  for (const auto& part : parts) {
+    result.checksum += part.checksum;
+    result.thetaMean += part.thetaMean;
+    result.thetaSigma += part.thetaSigma;
+    result.phiSigma += part.phiSigma;
+  }
+  result.thetaMean /= n;
+  result.thetaSigma = std::sqrt(result.thetaSigma / n -
+                                result.thetaMean * result.thetaMean);
+  result.phiSigma = std::sqrt(result.phiSigma / n);
+  return result;
+}
+
+GeneratorResult runAction(PrimarySampler::Engine engine,
+                          std::uint64_t nEvents, int particlesPerEvent,
+                          std::uint64_t seed) {
+  PrimaryGeneratorAction generator(particlesPerEvent, 1.0 * GeV, 1.0 * GeV,
+                                   0.035, 0.035);
+  generator.setSeed(seed);
+  generator.setRandomEngine(engine);
+
+  double start = Bench::now();
+  for (std::uint64_t eventId = 0; eventId < nEvents; eventId++) {
+    G4Event event(static_cast<int>(eventId));
+    generator.GeneratePrimaries(&event);
+  }
+  return {Bench::now() - start, false, 0, 0, 0, 0};
+}
+
+int main(int argc, char* argv[]) {
+  std::uint64_t nEvents = argc > 1 ? std::stoull(argv[1]) : 1000000;
+  int particlesPerEvent = argc > 2 ? std::stoi(argv[2]) : 1;
+  int nThreads = argc > 3 ? std::stoi(argv[3])
+                          : std::max(1u, std::thread::hardware_concurrency());
+  const std::uint64_t seed = 12345;
+  const double sigma = 0.035;
+
+  using Engine = PrimarySampler::Engine;
+  auto config = [&](Engine engine) {
+    return PrimarySampler::Config{.energyMin = 0.5 * GeV,
+                                  .energyMax = 1.5 * GeV,
+                                  .sigmaTheta = sigma,
+                                  .sigmaPhi = sigma,
+                                  .engine = engine,
+                                  .seed = seed};
+  };
+
+  struct Variant {
+    std::string name;
+    GeneratorResult result;
+  };
+  std::vector<Variant> variants;
+  variants.push_back(
+      {"mt19937", runSampler(config(Engine::kMersenneTwister), nEvents,
+                             particlesPerEvent, 1)});
+  variants.push_back({"philox", runSampler(config(Engine::kPhilox), nEvents,
+                                           particlesPerEvent, 1)});
+  variants.push_back({"philox x" + std::to_string(nThreads),
+                      runSampler(config(Engine::kPhilox), nEvents,
+                                 particlesPerEvent, nThreads)});
+
+  // Vertex creation included, the gun needs the electron definition
+  G4Electron::Definition();
+  variants.push_back(
+      {"action mt19937", runAction(Engine::kMersenneTwister, nEvents,
+                                   particlesPerEvent, seed)});
+  variants.push_back({"action philox", runAction(Engine::kPhilox, nEvents,
+                                                 particlesPerEvent, seed)});
+
+  double nPrimaries = static_cast<double>(nEvents) * particlesPerEvent;
+  std::printf("\n%-16s %14s %12s %16s %10s %10s %10s\n", "variant",
+              "primaries/s", "ns/primary", "checksum", "<theta>",
+              "sigmaTheta", "sigmaPhi");
+  for (const auto& [name, result] : variants) {
+    if (!result.sampled) {
+      std::printf("%-16s %14.4g %12.2f\n", name.c_str(),
+                  nPrimaries / result.seconds,
+                  1e9 * result.seconds / nPrimaries);
+      continue;
+    }
+    std::printf("%-16s %14.4g %12.2f %16.6f %10.2e %10.5f %10.5f\n",
+                name.c_str(), nPrimaries / result.seconds,
+                1e9 * result.seconds / nPrimaries, result.checksum,
+                result.thetaMean, result.thetaSigma, result.phiSigma);
+  }
+  std::printf("\nExpected sigma %.5f; the philox checksums %s\n", sigma,
+              std::abs(variants[1].result.checksum -
+                       variants[2].result.checksum) <
+                      1e-9 * std::abs(variants[1].result.checksum)
+                  ? "agree"
+                  : "DIFFER");
+  return 0;
+}
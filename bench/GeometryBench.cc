@@ -0,0 +1,135 @@
+// Compares the hit distributions and the throughput of the
+// geometry variants on the same fixed seed primaries. Geantinos
+// measure the navigation alone.
+//
+// Usage: alWindowGeoBench [nEvents] [outDir] [e-|geantino]
+
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "DetectorConstruction.hh"
+#include "FTFP_BERT.hh"
+#include "G4RunManager.hh"
+#include "G4StepLimiterPhysics.hh"
+#include "G4SystemOfUnits.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "Randomize.hh"
+#include "RunAction.hh"
+
+struct Variant {
+  std::string name;
+  std::function<void(DetectorConstruction*)> configure;
+};
+
+struct VariantResult {
+  double seconds;
+  std::uint64_t steps;
+  std::map<int, Bench::LayerSummary> layers;
+};
+
+int main(int argc, char* argv[]) {
+  int noe = argc > 1 ? std::stoi(argv[1]) : 10000;
+  std::string outDir = argc > 2 ? argv[2] : ".";
+  std::string particle = argc > 3 ? argv[3] : "e-";
+  const long seed = 12345;
+  const std::string treeName = "particles";
+
+  std::vector<Variant> variants{
+      {"detailed",
+       [](DetectorConstruction* dc) {
+         dc->tcDetail = TrackingChamberFactory::LevelOfDetail::kDetailed;
+       }},
+      {"fast",
+       [](DetectorConstruction* dc) {
+         dc->tcDetail = TrackingChamberFactory::LevelOfDetail::kFast;
+       }},
+      {"native-vc",
+       [](DetectorConstruction* dc) {
+         dc->tcDetail = TrackingChamberFactory::LevelOfDetail::kDetailed;
+         dc->vcSolidModel = VacuumChamberFactory::SolidModel::kNative;
+       }},
+      {"fast+native",
+       [](DetectorConstruction* dc) {
+         dc->tcDetail = TrackingChamberFactory::LevelOfDetail::kFast;
+         dc->vcSolidModel = VacuumChamberFactory::SolidModel::kNative;
+       }}};
+
+  G4RunManager* runManager = new G4RunManager();
+
+  auto detector = new DetectorConstruction(0 * mm, 0 * mm);
+  runManager->SetUserInitialization(detector);
+  auto physicsList = new FTFP_BERT(0);
+  physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+  runManager->SetUserInitialization(physicsList);
+
+  auto generator =
+      new PrimaryGeneratorAction(1, 1.0 * GeV, 1.0 * GeV, 0.035, 0.035);
+  generator->setParticle(particle);
+  runManager->SetUserAction(generator);
+  auto runAction = new RunAction("", treeName, 0);
+  runManager->SetUserAction(runAction);
+  auto stepCounter = new Bench::StepCounter();
+  runManager->SetUserAction(stepCounter);
+
+  std::vector<VariantResult> results;
+  for (std::size_t i = 0; i < variants.size(); i++) {
+    variants[i].configure(detector);
+    if (i == 0) {
+      runManager->Initialize();
+    } else {
+      runManager->ReinitializeGeometry(true);
+    }
+    runAction->setFilePath(outDir + "/geoBench_" + variants[i].name + ".root");
+
+    generator->setSeed(seed);
+    G4Random::setTheSeed(seed);
+    stepCounter->reset();
+
+    double start = Bench::now();
+    runManager->BeamOn(noe);
+    results.push_back({Bench::now() - start, stepCounter->steps(), {}});
+  }
+  // Closes the output of the last run
+  delete runManager;
+
+  for (std::size_t i = 0; i < variants.size(); i++) {
+    results[i].layers = Bench::summarizeLayers(
+        outDir + "/geoBench_" + variants[i].name + ".root", treeName);
+  }
+
+  std::printf("\n%-12s %12s %12s %12s %12s\n", "variant", "events/s",
+              "steps/event", "us/step", "us/primary");
+  for (std::size_t i = 0; i < variants.size(); i++) {
+    std::printf("%-12s %12.1f %12.1f %12.3f %12.1f\n", variants[i].name.c_str(),
+                noe / results[i].seconds,
+                static_cast<double>(results[i].steps) / noe,
+                1e6 * results[i].seconds / results[i].steps,
+                1e6 * results[i].seconds / noe);
+  }
+
+  // Hits relative to the first variant
+  const auto& reference = results.front().layers;
+  for (std::size_t i = 1; i < variants.size(); i++) {
+    std::printf("\n%s vs %s\n%6s %14s %14s %12s %12s\n",
+                variants[i].name.c_str(), variants.front().name.c_str(),
+                "geoId", "pixels/event", "pixel ratio", "dEDep [%]",
+                "dX,dY [um]");
+    for (const auto& [id, ref] : reference) {
+      auto it = results[i].layers.find(id);
+      if (it == results[i].layers.end()) {
+        std::printf("%6d %14s\n", id, "no hits");
+        continue;
+      }
+      const Bench::LayerSummary& layer = it->second;
+      std::printf("%6d %14.4f %14.4f %12.2f %6.1f,%5.1f\n", id,
+                  static_cast<double>(layer.pixels) / noe,
+                  static_cast<double>(layer.pixels) / ref.pixels,
+                  100.0 * (layer.eDep / ref.eDep - 1.0),
+                  (layer.x - ref.x) / um, (layer.y - ref.y) / um);
+    }
+  }
+  return 0;
+}
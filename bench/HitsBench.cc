@@ -0,0 +1,204 @@
+// Times the two hottest user functions outside of a Geant4 run:
+// SamplingVolume::ProcessHits on synthetic steps placed in the real
+// ALPIDE sensors, and Run::RecordEvent on the hit collections these
+// steps produce, with the null, ROOT pixel layout, ROOT event layout
+// and binary output sinks; the differences are the cost of the I/O.
+// The steps come in groups of four within a pixel pitch, so the
+// pixels collect several hits as they do in a cluster.
+//
+// Usage: alWindowHitsBench [nSteps] [hitsPerEvent,...] [outDir]
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "DetectorConstruction.hh"
+#include "G4DynamicParticle.hh"
+#include "G4Electron.hh"
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4LogicalVolume.hh"
+#include "G4Navigator.hh"
+#include "G4RunManager.hh"
+#include "G4SDManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4TouchableHistory.hh"
+#include "G4Track.hh"
+#include "G4TransportationManager.hh"
+#include "PhysicsListFactory.hh"
+#include "PixelGeometry.hh"
+#include "PlacementWalker.hh"
+#include "Run.hh"
+#include "SamplingVolume.hh"
+
+struct Sensor {
+  G4RotationMatrix rotation;
+  G4ThreeVector translation;
+  G4TouchableHandle touchable;
+};
+
+/// Steps with their tracks, reused in turn
+struct StepPool {
+  std::vector<std::unique_ptr<G4Track>> tracks;
+  std::vector<std::unique_ptr<G4Step>> steps;
+  std::size_t next = 0;
+
+  G4Step* get() {
+    G4Step* step = steps[next].get();
+    next = next + 1 < steps.size() ? next + 1 : 0;
+    return step;
+  }
+};
+
+StepPool makeSteps(const std::vector<Sensor>& sensors, std::size_t n) {
+  std::mt19937 rng(12345);
+  std::uniform_int_distribution<std::size_t> pickSensor(0,
+                                                        sensors.size() - 1);
+  std::uniform_real_distribution<> uniform(-0.5, 0.5);
+  auto* electron = G4Electron::Definition();
+
+  StepPool pool;
+  const Sensor* sensor = nullptr;
+  G4ThreeVector center;
+  for (std::size_t i = 0; i < n; i++) {
+    if (i % 4 == 0) {
+      sensor = &sensors[pickSensor(rng)];
+      center = {uniform(rng) * 0.9 * PixelGeometry::chipX,
+                uniform(rng) * 0.9 * PixelGeometry::chipY, 0};
+    }
+    G4ThreeVector jitter(uniform(rng) * PixelGeometry::pixelX,
+                         uniform(rng) * PixelGeometry::pixelY, 0);
+    G4ThreeVector local = center + jitter;
+    G4ThreeVector position = sensor->rotation * local + sensor->translation;
+    G4ThreeVector direction = sensor->rotation * G4ThreeVector(0, 0, 1);
+
+    auto track = std::make_unique<G4Track>(
+        new G4DynamicParticle(electron, direction, 1.0 * GeV), 0, position);
+    track->SetTrackID(1);
+    track->SetParentID(0);
+    track->SetTouchableHandle(sensor->touchable);
+    track->SetVertexPosition(G4ThreeVector());
+    track->SetVertexMomentumDirection(direction);
+    track->SetVertexKineticEnergy(1.0 * GeV);
+
+    auto step = std::make_unique<G4Step>();
+    step->SetTrack(track.get());
+    step->GetPreStepPoint()->SetPosition(position - 25 * um * direction);
+    step->GetPostStepPoint()->SetPosition(position);
+    step->SetTotalEnergyDeposit(5 * keV);
+
+    pool.tracks.push_back(std::move(track));
+    pool.steps.push_back(std::move(step));
+  }
+  return pool;
+}
+
+int main(int argc, char* argv[]) {
+  std::uint64_t nSteps = argc > 1 ? std::stoull(argv[1]) : 1000000;
+  std::string sizeList = argc > 2 ? argv[2] : "10,100,1000,10000";
+  std::string outDir = argc > 3 ? argv[3] : ".";
+
+  std::vector<std::size_t> sizes;
+  std::istringstream sizeStream(sizeList);
+  for (std::string size; std::getline(sizeStream, size, ',');) {
+    sizes.push_back(std::stoull(size));
+  }
+
+  // Geometry and sensitive detector, no events are processed
+  G4RunManager* runManager = new G4RunManager();
+  runManager->SetVerboseLevel(0);
+  runManager->SetUserInitialization(new DetectorConstruction(0, 0));
+  PhysicsListFactory physicsFactory;
+  runManager->SetUserInitialization(physicsFactory.construct(
+      {.model = PhysicsListFactory::Model::kFtfpBert,
+       .gammaNuclear = false,
+       .stepLimiter = true,
+       .verbose = 0}));
+  runManager->Initialize();
+
+  auto* navigator = G4TransportationManager::GetTransportationManager()
+                        ->GetNavigatorForTracking();
+  std::vector<Sensor> sensors;
+  walkPlacements(navigator->GetWorldVolume(),
+                 [&](const G4VPhysicalVolume* volume,
+                     const G4RotationMatrix& rotation,
+                     const G4ThreeVector& translation) {
+                   if (volume->GetLogicalVolume()->GetName() ==
+                       "logicAlpideSensitive") {
+                     sensors.push_back({rotation, translation, {}});
+                   }
+                   return true;
+                 });
+  for (Sensor& sensor : sensors) {
+    navigator->LocateGlobalPointAndSetup(sensor.translation);
+    sensor.touchable = G4TouchableHandle(navigator->CreateTouchableHistory());
+  }
+  if (sensors.empty()) {
+    std::fprintf(stderr, "No ALPIDE sensors in the geometry\n");
+    return 1;
+  }
+
+  auto* sdManager = G4SDManager::GetSDMpointer();
+  auto* samplingVolume = static_cast<SamplingVolume*>(
+      sdManager->FindSensitiveDetector("/logicAlpideSensitive"));
+  StepPool pool = makeSteps(sensors, 1 << 16);
+
+  std::printf(
+      "\n%d sensors, %llu steps per size\n%12s %16s %18s %18s %18s "
+      "%18s\n",
+      static_cast<int>(sensors.size()),
+      static_cast<unsigned long long>(nSteps), "hits/event", "ProcessHits",
+      "RecordEvent null", "RecordEvent ROOT", "RecordEvent evt",
+      "RecordEvent bin");
+  std::printf("%12s %16s %18s %18s %18s %18s\n", "", "[ns/step]",
+              "[ns/hit]", "[ns/hit]", "[ns/hit]", "[ns/hit]");
+  for (std::size_t size : sizes) {
+    std::uint64_t nEvents = std::max<std::uint64_t>(1, nSteps / size);
+
+    // The collection of the last event is recorded below
+    G4HCofThisEvent* hce = nullptr;
+    double processSeconds = 0;
+    for (std::uint64_t e = 0; e < nEvents; e++) {
+      delete hce;
+      hce = new G4HCofThisEvent(sdManager->GetCollectionCapacity());
+      samplingVolume->Initialize(hce);
+      double start = Bench::now();
+      for (std::size_t j = 0; j < size; j++) {
+        samplingVolume->ProcessHits(pool.get(), nullptr);
+      }
+      processSeconds += Bench::now() - start;
+    }
+    G4Event event;
+    event.SetHCofThisEvent(hce);
+
+    auto timeRecord = [&](OutputSink::Format format) {
+      std::string filePath = outDir + "/hitsBench_" + std::to_string(size) +
+                             OutputSink::extension(format);
+      Run run(filePath, "particles", 0, {.format = format});
+      double start = Bench::now();
+      for (std::uint64_t e = 0; e < nEvents; e++) {
+        run.RecordEvent(&event);
+      }
+      return Bench::now() - start;
+    };
+    double nullSeconds = timeRecord(OutputSink::Format::kNull);
+    double rootSeconds = timeRecord(OutputSink::Format::kRoot);
+    double eventsSeconds = timeRecord(OutputSink::Format::kRootEvents);
+    double binarySeconds = timeRecord(OutputSink::Format::kBinary);
+
+    double nHits = static_cast<double>(nEvents) * size;
+    std::printf("%12zu %16.1f %18.1f %18.1f %18.1f %18.1f\n", size,
+                1e9 * processSeconds / nHits, 1e9 * nullSeconds / nHits,
+                1e9 * rootSeconds / nHits, 1e9 * eventsSeconds / nHits,
+                1e9 * binarySeconds / nHits);
+  }
+
+  delete runManager;
+  return 0;
+}
@@ -0,0 +1,129 @@
+// Compares the start-up time, the throughput and the hits of the
+// physics lists on the same fixed seed primaries. Every list runs
+// in its own process.
+//
+// Usage: alWindowPhysBench [nEvents] [outDir]
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "DetectorConstruction.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "PhysicsListFactory.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "Randomize.hh"
+#include "RunAction.hh"
+
+struct PhysicsResult {
+  double initSeconds;
+  double tablesSeconds;
+  double runSeconds;
+  std::uint64_t steps;
+};
+
+int main(int argc, char* argv[]) {
+  int noe = argc > 1 ? std::stoi(argv[1]) : 10000;
+  std::string outDir = argc > 2 ? argv[2] : ".";
+  const long seed = 12345;
+  const std::string treeName = "particles";
+
+  using Model = PhysicsListFactory::Model;
+  std::vector<PhysicsListFactory::Config> configs;
+  for (auto [model, gammaNuclear] :
+       {std::pair{Model::kFtfpBert, false}, {Model::kEmStandard, false},
+        {Model::kEmStandardOpt3, false}, {Model::kEmStandardOpt4, false},
+        {Model::kEmStandardOpt4, true}}) {
+    configs.push_back({.model = model,
+                       .gammaNuclear = gammaNuclear,
+                       .stepLimiter = true,
+                       .verbose = 0});
+  }
+
+  auto filePath = [&](const PhysicsListFactory::Config& cfg) {
+    return outDir + "/physBench_" + PhysicsListFactory::name(cfg) + ".root";
+  };
+
+  std::vector<std::optional<PhysicsResult>> results;
+  for (const auto& cfg : configs) {
+    results.push_back(Bench::runIsolated<PhysicsResult>([&]() {
+      PhysicsResult result;
+      double start = Bench::now();
+
+      G4RunManager* runManager = new G4RunManager();
+      runManager->SetVerboseLevel(0);
+      runManager->SetUserInitialization(new DetectorConstruction(0, 0));
+      PhysicsListFactory physicsFactory;
+      runManager->SetUserInitialization(physicsFactory.construct(cfg));
+
+      auto generator =
+          new PrimaryGeneratorAction(1, 1.0 * GeV, 1.0 * GeV, 0.035, 0.035);
+      generator->setSeed(seed);
+      runManager->SetUserAction(generator);
+      runManager->SetUserAction(new RunAction(filePath(cfg), treeName, 0));
+      auto stepCounter = new Bench::StepCounter();
+      runManager->SetUserAction(stepCounter);
+
+      runManager->Initialize();
+      result.initSeconds = Bench::now() - start;
+
+      // The physics tables are built at the first run
+      start = Bench::now();
+      runManager->BeamOn(0);
+      result.tablesSeconds = Bench::now() - start;
+
+      G4Random::setTheSeed(seed);
+      start = Bench::now();
+      runManager->BeamOn(noe);
+      result.runSeconds = Bench::now() - start;
+      result.steps = stepCounter->steps();
+
+      delete runManager;
+      return result;
+    }));
+  }
+
+  std::printf("\n%-10s %10s %10s %12s %12s %12s\n", "physics", "init [s]",
+              "tables [s]", "events/s", "steps/event", "us/step");
+  for (std::size_t i = 0; i < configs.size(); i++) {
+    const std::string name = PhysicsListFactory::name(configs[i]);
+    if (!results[i]) {
+      std::printf("%-10s %10s\n", name.c_str(), "failed");
+      continue;
+    }
+    const PhysicsResult& result = *results[i];
+    std::printf("%-10s %10.2f %10.2f %12.1f %12.1f %12.3f\n", name.c_str(),
+                result.initSeconds, result.tablesSeconds,
+                noe / result.runSeconds,
+                static_cast<double>(result.steps) / noe,
+                1e6 * result.runSeconds / result.steps);
+  }
+
+  // Hits relative to FTFP_BERT
+  auto reference = Bench::summarizeLayers(filePath(configs.front()), treeName);
+  for (std::size_t i = 1; i < configs.size(); i++) {
+    if (!results[i]) {
+      continue;
+    }
+    auto layers = Bench::summarizeLayers(filePath(configs[i]), treeName);
+    std::printf("\n%s vs %s\n%6s %14s %14s %12s\n",
+                PhysicsListFactory::name(configs[i]).c_str(),
+                PhysicsListFactory::name(configs.front()).c_str(), "geoId",
+                "pixels/event", "pixel ratio", "dEDep [%]");
+    for (const auto& [id, ref] : reference) {
+      auto it = layers.find(id);
+      if (it == layers.end()) {
+        std::printf("%6d %14s\n", id, "no hits");
+        continue;
+      }
+      const Bench::LayerSummary& layer = it->second;
+      std::printf("%6d %14.4f %14.4f %12.2f\n", id,
+                  static_cast<double>(layer.pixels) / noe,
+                  static_cast<double>(layer.pixels) / ref.pixels,
+                  100.0 * (layer.eDep / ref.eDep - 1.0));
+    }
+  }
+  return 0;
+}
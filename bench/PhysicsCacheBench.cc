@@ -0,0 +1,122 @@
+// Measures the start-up time saved by the physics table cache.
+// Every physics list starts without the cache, with an empty
+// cache that stores the tables and with the filled cache. The
+// step count of the following fixed seed run checks that the
+// retrieved tables reproduce the built ones.
+//
+// Usage: alWindowCacheBench [nEvents] [outDir]
+
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "DetectorConstruction.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "PhysicsListFactory.hh"
+#include "PhysicsTableCache.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "Randomize.hh"
+#include "RunAction.hh"
+
+enum class CacheMode { kOff, kCold, kWarm };
+
+struct StartupResult {
+  double initSeconds;
+  double tablesSeconds;
+  double storeSeconds;
+  bool retrieved;
+  std::uint64_t steps;
+};
+
+int main(int argc, char* argv[]) {
+  int noe = argc > 1 ? std::stoi(argv[1]) : 1000;
+  std::string outDir = argc > 2 ? argv[2] : ".";
+  const long seed = 12345;
+  const std::string cacheDir = outDir + "/physicsTableCache";
+
+  std::vector<PhysicsListFactory::Config> configs{
+      {.model = PhysicsListFactory::Model::kFtfpBert,
+       .gammaNuclear = false,
+       .stepLimiter = true,
+       .verbose = 0},
+      {.model = PhysicsListFactory::Model::kEmStandardOpt4,
+       .gammaNuclear = false,
+       .stepLimiter = true,
+       .verbose = 0}};
+  const std::vector<std::pair<CacheMode, std::string>> modes{
+      {CacheMode::kOff, "off"},
+      {CacheMode::kCold, "cold"},
+      {CacheMode::kWarm, "warm"}};
+
+  std::filesystem::remove_all(cacheDir);
+
+  std::printf("\n%-10s %6s %10s %10s %10s %10s %12s\n", "physics", "cache",
+              "init [s]", "tables [s]", "store [s]", "retrieved", "steps");
+  for (const auto& cfg : configs) {
+    const std::string name = PhysicsListFactory::name(cfg);
+    for (const auto& [mode, modeName] : modes) {
+      auto result = Bench::runIsolated<StartupResult>([&]() {
+        StartupResult result{};
+        double start = Bench::now();
+
+        G4RunManager* runManager = new G4RunManager();
+        runManager->SetVerboseLevel(0);
+        runManager->SetUserInitialization(new DetectorConstruction(0, 0));
+        PhysicsListFactory physicsFactory;
+        auto physicsList = physicsFactory.construct(cfg);
+        runManager->SetUserInitialization(physicsList);
+
+        auto generator =
+            new PrimaryGeneratorAction(1, 1.0 * GeV, 1.0 * GeV, 0.035, 0.035);
+        generator->setSeed(seed);
+        runManager->SetUserAction(generator);
+        runManager->SetUserAction(new RunAction(
+            outDir + "/cacheBench_" + name + "_" + modeName + ".root",
+            "particles", 0));
+        auto stepCounter = new Bench::StepCounter();
+        runManager->SetUserAction(stepCounter);
+
+        runManager->Initialize();
+        result.initSeconds = Bench::now() - start;
+
+        PhysicsTableCache cache(
+            {.cacheDir = cacheDir, .physicsListName = name});
+        if (mode != CacheMode::kOff) {
+          cache.retrieve(physicsList);
+        }
+        start = Bench::now();
+        runManager->BeamOn(0);
+        result.tablesSeconds = Bench::now() - start;
+
+        if (mode != CacheMode::kOff) {
+          start = Bench::now();
+          cache.store(physicsList);
+          result.storeSeconds = Bench::now() - start;
+          result.retrieved = physicsList->IsPhysicsTableRetrieved();
+        }
+
+        G4Random::setTheSeed(seed);
+        runManager->BeamOn(noe);
+        result.steps = stepCounter->steps();
+
+        delete runManager;
+        return result;
+      });
+
+      if (!result) {
+        std::printf("%-10s %6s %10s\n", name.c_str(), modeName.c_str(),
+                    "failed");
+        continue;
+      }
+      std::printf("%-10s %6s %10.2f %10.2f %10.2f %10s %12llu\n",
+                  name.c_str(), modeName.c_str(), result->initSeconds,
+                  result->tablesSeconds, result->storeSeconds,
+                  result->retrieved ? "yes" : "no",
+                  static_cast<unsigned long long>(result->steps));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,115 @@
+// Write and read throughput of the pixel records in the particles.root
+// tree layout and as an RNTuple, on the same synthetic records: a few
+// hits per pixel, one primary per event. The RNTuple is also written
+// from nThreads threads sharing one parallel writer. Every file is
+// read twice, all fields and the geoId, totEDep and hitE of a typical
+// analysis; the second pass, from the page cache, is reported.
+//
+// Usage: alWindowReadBench [nPixels] [nThreads] [outDir]
+
+#include <array>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "OutputSink.hh"
+
+#ifdef WITH_RNTUPLE
+#include "ROOT/RNTupleReader.hxx"
+#endif
+
+namespace {
+
+const char* treeName = "particles";
+
+#ifdef WITH_RNTUPLE
+Bench::ReadResult readNTuple(const std::string& filePath, bool allFields) {
+  Bench::ReadResult result{};
+  double start = Bench::now();
+  auto reader = ROOT::RNTupleReader::Open(treeName, filePath);
+  std::uint64_t nEntries = reader->GetNEntries();
+  if (allFields) {
+    auto entry = reader->CreateEntry();
+    auto hitE = entry->GetPtr<std::vector<double>>("hitE");
+    for (std::uint64_t i = 0; i < nEntries; i++) {
+      reader->LoadEntry(i, *entry);
+      result.pixels++;
+      result.hits += hitE->size();
+    }
+  } else {
+    auto geoId = reader->GetView<int>("geoId");
+    auto totEDep = reader->GetView<double>("totEDep");
+    auto hitE = reader->GetView<std::vector<double>>("hitE");
+    for (std::uint64_t i = 0; i < nEntries; i++) {
+      geoId(i);
+      totEDep(i);
+      result.pixels++;
+      result.hits += hitE(i).size();
+    }
+  }
+  result.seconds = Bench::now() - start;
+  return result;
+}
+#endif
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::uint64_t nPixels = argc > 1 ? std::stoull(argv[1]) : 1000000;
+  int nThreads = argc > 2 ? std::stoi(argv[2]) : 4;
+  std::string outDir = argc > 3 ? argv[3] : ".";
+
+  struct Layout {
+    const char* name;
+    OutputSink::Format format;
+    int nThreads;
+  };
+  std::vector<Layout> layouts{{"TTree", OutputSink::Format::kRoot, 1}};
+#ifdef WITH_RNTUPLE
+  layouts.push_back({"RNTuple", OutputSink::Format::kRNTuple, 1});
+  if (nThreads > 1) {
+    layouts.push_back({"RNTuple MT", OutputSink::Format::kRNTuple, nThreads});
+  }
+#else
+  std::fprintf(stderr, "No RNTuple support, ROOT 6.36 or later is needed\n");
+#endif
+
+  std::printf("\n%llu pixels\n%-12s %8s %10s %10s %13s %11s %11s %11s\n",
+              static_cast<unsigned long long>(nPixels), "layout", "threads",
+              "file [MB]", "write [s]", "read all [s]", "read 3 [s]",
+              "all [MB/s]", "all [Mhit/s]");
+  for (const Layout& layout : layouts) {
+    std::string filePath = outDir + "/readBench_" +
+                           std::to_string(layout.nThreads) +
+                           OutputSink::extension(layout.format);
+    double writeSeconds = Bench::writeSynthetic(
+        {.format = layout.format}, filePath, treeName, nPixels,
+        layout.nThreads);
+    std::uint64_t bytes = Bench::fileBytes(filePath);
+
+    auto read = [&](bool allFields) {
+#ifdef WITH_RNTUPLE
+      if (layout.format == OutputSink::Format::kRNTuple) {
+        return readNTuple(filePath, allFields);
+      }
+#endif
+      return Bench::readTree(filePath, treeName, allFields);
+    };
+    read(true);
+    Bench::ReadResult all = read(true);
+    read(false);
+    Bench::ReadResult some = read(false);
+    if (all.pixels != nPixels || some.pixels != nPixels) {
+      std::fprintf(stderr, "%s: read %llu of %llu pixels\n", layout.name,
+                   static_cast<unsigned long long>(all.pixels),
+                   static_cast<unsigned long long>(nPixels));
+    }
+
+    std::printf("%-12s %8d %10.1f %10.3f %13.3f %11.3f %11.1f %11.2f\n",
+                layout.name, layout.nThreads, bytes / 1e6, writeSeconds,
+                all.seconds, some.seconds, bytes / 1e6 / all.seconds,
+                all.hits / 1e6 / all.seconds);
+  }
+  return 0;
+}
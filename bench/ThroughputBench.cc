@@ -0,0 +1,214 @@
+// Throughput of the full simulation in fixed seed scenarios, for
+// tracking the performance from commit to commit: single 1 GeV
+// electrons, the measured Xe momenta, high occupancy events of
+// many electrons and geantinos for the navigation alone. Every
+// scenario runs in its own process through the real detector and
+// actions. The results are printed as a table and written as JSON.
+// Without a momenta file the Xe scenario is skipped. The output
+// format is root, root-events, binary, rntuple or null; against null
+// the difference is the share of the I/O in the run time.
+//
+// Usage: alWindowBench [nEvents] [outDir] [momenta.txt|-] [result.json|-]
+//                      [root|root-events|binary|rntuple|null]
+
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include "BenchCommon.hh"
+#include "DetectorConstruction.hh"
+#include "G4RunManager.hh"
+#include "G4SystemOfUnits.hh"
+#include "OutputSink.hh"
+#include "PhysicsListFactory.hh"
+#include "PrimaryGeneratorAction.hh"
+#include "PrimaryIndexTrackingAction.hh"
+#include "Randomize.hh"
+#include "ReadoutPrimaryGeneratorAction.hh"
+#include "RunAction.hh"
+
+struct ScenarioResult {
+  double initSeconds;
+  double runSeconds;
+  std::uint64_t steps;
+  std::uint64_t outputBytes;
+  long peakRssKb;
+};
+
+struct Scenario {
+  std::string name;
+  int nEvents;
+  int primariesPerEvent;
+
+  /// Installs the generator and any extra actions
+  std::function<void(G4RunManager*)> configure;
+};
+
+namespace {
+
+void writeJson(std::FILE* out, int nEvents, const std::string& output,
+               const std::vector<Scenario>& scenarios,
+               const std::vector<std::optional<ScenarioResult>>& results) {
+  std::fprintf(out, "{\n  \"benchmark\": \"alWindowBench\",\n");
+  std::fprintf(out,
+               "  \"nEvents\": %d,\n  \"output\": \"%s\",\n"
+               "  \"scenarios\": [",
+               nEvents, output.c_str());
+  bool first = true;
+  for (std::size_t i = 0; i < scenarios.size(); i++) {
+    if (!results[i]) {
+      continue;
+    }
+    const Scenario& scenario = scenarios[i];
+    const ScenarioResult& result = *results[i];
+    std::fprintf(out,
+                 "%s\n    {\"name\": \"%s\", \"events\": %d, "
+                 "\"primariesPerEvent\": %d, \"initSeconds\": %.4f, "
+                 "\"runSeconds\": %.4f, \"eventsPerSecond\": %.6g, "
+                 "\"stepsPerSecond\": %.6g, \"stepsPerEvent\": %.6g, "
+                 "\"peakRssMB\": %.1f, \"outputBytesPerEvent\": %.6g}",
+                 first ? "" : ",", scenario.name.c_str(), scenario.nEvents,
+                 scenario.primariesPerEvent, result.initSeconds,
+                 result.runSeconds, scenario.nEvents / result.runSeconds,
+                 result.steps / result.runSeconds,
+                 static_cast<double>(result.steps) / scenario.nEvents,
+                 result.peakRssKb / 1024.0,
+                 static_cast<double>(result.outputBytes) / scenario.nEvents);
+    first = false;
+  }
+  std::fprintf(out, "\n  ]\n}\n");
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  int noe = argc > 1 ? std::stoi(argv[1]) : 10000;
+  std::string outDir = argc > 2 ? argv[2] : ".";
+  std::string momentumPath = argc > 3 ? argv[3] : "-";
+  std::string jsonPath = argc > 4 ? argv[4] : "-";
+  std::string output = argc > 5 ? argv[5] : "root";
+  const long seed = 12345;
+  const std::string treeName = "particles";
+  const int occupancy = 100;
+  auto format = OutputSink::formatFromName(output);
+  if (!format) {
+    std::fprintf(stderr,
+                 "Unknown output %s, expected root, root-events, binary, "
+                 "rntuple or null\n",
+                 output.c_str());
+    return 1;
+  }
+
+  auto beam = [seed](int nParticles, const G4String& particle) {
+    return [=](G4RunManager* runManager) {
+      auto generator = new PrimaryGeneratorAction(nParticles, 1.0 * GeV,
+                                                  1.0 * GeV, 0.035, 0.035);
+      generator->setSeed(seed);
+      generator->setParticle(particle);
+      runManager->SetUserAction(generator);
+      if (nParticles > 1) {
+        runManager->SetUserAction(new PrimaryIndexTrackingAction());
+      }
+    };
+  };
+
+  std::vector<Scenario> scenarios{
+      {"electron", noe, 1, beam(1, "e-")},
+      {"occupancy", std::max(1, noe / occupancy), occupancy,
+       beam(occupancy, "e-")},
+      {"geometry", noe, 1, beam(1, "geantino")}};
+  if (momentumPath != "-") {
+    scenarios.insert(scenarios.begin() + 1,
+                     {"xe", noe, 1, [&](G4RunManager* runManager) {
+                        auto generator =
+                            new ReadoutPrimaryGeneratorAction(momentumPath);
+                        generator->setSeed(seed);
+                        runManager->SetUserAction(generator);
+                      }});
+  }
+
+  std::vector<std::optional<ScenarioResult>> results;
+  for (const Scenario& scenario : scenarios) {
+    std::string filePath =
+        outDir + "/bench_" + scenario.name + OutputSink::extension(*format);
+    results.push_back(Bench::runIsolated<ScenarioResult>([&]() {
+      ScenarioResult result;
+      double start = Bench::now();
+
+      G4RunManager* runManager = new G4RunManager();
+      runManager->SetVerboseLevel(0);
+      runManager->SetUserInitialization(new DetectorConstruction(0, 0));
+      PhysicsListFactory physicsFactory;
+      runManager->SetUserInitialization(physicsFactory.construct(
+          {.model = PhysicsListFactory::Model::kFtfpBert,
+           .gammaNuclear = false,
+           .stepLimiter = true,
+           .verbose = 0}));
+      scenario.configure(runManager);
+      auto runAction = new RunAction(filePath, treeName, 0);
+      runAction->setOutputConfig({.format = *format});
+      runManager->SetUserAction(runAction);
+      auto stepCounter = new Bench::StepCounter();
+      runManager->SetUserAction(stepCounter);
+
+      runManager->Initialize();
+      runManager->BeamOn(0);
+      result.initSeconds = Bench::now() - start;
+
+      G4Random::setTheSeed(seed);
+      start = Bench::now();
+      runManager->BeamOn(scenario.nEvents);
+      result.runSeconds = Bench::now() - start;
+      result.steps = stepCounter->steps();
+
+      // Closes the output of the run
+      delete runManager;
+      std::error_code ec;
+      result.outputBytes = std::filesystem::file_size(filePath, ec);
+      if (ec) {
+        result.outputBytes = 0;
+      }
+
+      rusage usage;
+      getrusage(RUSAGE_SELF, &usage);
+      result.peakRssKb = usage.ru_maxrss;
+      return result;
+    }));
+  }
+
+  std::printf("\n%-10s %8s %10s %12s %12s %10s %12s\n", "scenario",
+              "events", "init [s]", "events/s", "steps/s", "RSS [MB]",
+              "bytes/event");
+  for (std::size_t i = 0; i < scenarios.size(); i++) {
+    const Scenario& scenario = scenarios[i];
+    if (!results[i]) {
+      std::printf("%-10s %8s\n", scenario.name.c_str(), "failed");
+      continue;
+    }
+    const ScenarioResult& result = *results[i];
+    std::printf("%-10s %8d %10.2f %12.1f %12.4g %10.1f %12.1f\n",
+                scenario.name.c_str(), scenario.nEvents, result.initSeconds,
+                scenario.nEvents / result.runSeconds,
+                result.steps / result.runSeconds, result.peakRssKb / 1024.0,
+                static_cast<double>(result.outputBytes) / scenario.nEvents);
+  }
+
+  std::printf("\n");
+  writeJson(stdout, noe, output, scenarios, results);
+  if (jsonPath != "-") {
+    std::FILE* file = std::fopen(jsonPath.c_str(), "w");
+    if (file == nullptr) {
+      std::fprintf(stderr, "Cannot write %s\n", jsonPath.c_str());
+      return 1;
+    }
+    writeJson(file, noe, output, scenarios, results);
+    std::fclose(file);
+  }
+  return 0;
+}
@@ -0,0 +1,89 @@
+#ifndef AcceptanceFilter_h
+#define AcceptanceFilter_h
+
+#include <cstdint>
+#include <vector>
+
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+
+class G4VPhysicalVolume;
+
+/// Analytic pre-filter of the primaries. A primary is propagated
+/// along a straight line, and along a helix inside the uniform
+/// field volume, ignoring the material. It is inside the acceptance
+/// if the path crosses a sensitive volume enlarged by the margin.
+class AcceptanceFilter {
+ public:
+  /// Primaries outside the acceptance are skipped, or simulated
+  /// with the probability keepFraction and the weight 1/keepFraction
+  /// to measure the bias of skipping them
+  enum class Mode { kSkip, kWeight };
+
+  struct Config {
+    /// Distance to the sensitive volume edges still accepted
+    double margin;
+
+    Mode mode;
+
+    /// Fraction of the rejected primaries simulated, (0, 1)
+    double keepFraction;
+  };
+
+  struct Stats {
+    std::uint64_t generated = 0;
+    std::uint64_t accepted = 0;
+    std::uint64_t rejectedSimulated = 0;
+    std::uint64_t skipped = 0;
+  };
+
+  explicit AcceptanceFilter(const Config& cfg);
+  ~AcceptanceFilter() = default;
+
+  /// Read the sensors and the field volume of the current
+  /// geometry. Call at the start of every run
+  void update(const G4VPhysicalVolume* world);
+
+  /// Does the path of the particle reach a sensor
+  bool accepts(const G4ThreeVector& position, const G4ThreeVector& momentum,
+               double charge) const;
+
+  struct Decision {
+    /// Event weight, 0 if the primary is skipped
+    double weight;
+
+    bool outsideAcceptance;
+  };
+
+  /// Decide on a primary and count it. uniform is a uniform
+  /// random number in [0, 1)
+  Decision decide(const G4ThreeVector& position, const G4ThreeVector& momentum,
+                  double charge, double uniform);
+
+  const Config& config() const { return m_cfg; }
+  const Stats& stats() const { return m_stats; }
+  void resetStats() { m_stats = Stats(); }
+
+ private:
+  /// Box placed in the world, the rotation takes the box
+  /// frame to the global one
+  struct Box {
+    G4ThreeVector center;
+    G4RotationMatrix rotation;
+    G4ThreeVector halfSize;
+  };
+
+  /// Does the segment cross an enlarged sensor
+  bool hitsSensor(const G4ThreeVector& from, const G4ThreeVector& to) const;
+
+  Config m_cfg;
+  Stats m_stats;
+
+  std::vector<Box> m_sensors;
+
+  bool m_hasField = false;
+  Box m_fieldBox;
+  G4ThreeVector m_field;
+};
+
+#endif
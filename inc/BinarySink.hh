@@ -0,0 +1,33 @@
+#ifndef BinarySink_h
+#define BinarySink_h
+
+#include <fstream>
+#include <vector>
+
+#include "OutputSink.hh"
+
+/// Pixel blocks of PixelStream.hh, collected in a buffer that is
+/// appended to the file whenever it exceeds bufferSize
+class BinarySink : public OutputSink {
+ public:
+  BinarySink(const std::string& filePath, const PixelRecord& record);
+  ~BinarySink() override;
+
+  void write() override;
+  void close(const Metadata& metadata) override;
+
+  std::uint64_t bufferedBytes() const override { return m_buffer.size(); }
+  void flush() override;
+
+ private:
+  static constexpr std::size_t bufferSize = 1 << 20;
+
+  template <typename T>
+  void append(const T& block);
+
+  const PixelRecord& m_record;
+  std::ofstream m_file;
+  std::vector<char> m_buffer;
+};
+
+#endif
@@ -1,21 +1,32 @@
 #ifndef DetectorConstruction_h
 #define DetectorConstruction_h
 
+#include <tuple>
+#include <unordered_map>
+
 #include "G4LogicalBorderSurface.hh"
 #include "G4NistManager.hh"
 #include "G4RunManager.hh"
 #include "G4ThreeVector.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VUserDetectorConstruction.hh"
+#include "TrackingChamberFactory.hh"
+#include "VacuumChamberFactory.hh"
 
 class G4LogicalVolume;
 class G4PhysicalVolume;
 
 class DetectorConstruction : public G4VUserDetectorConstruction {
  public:
-  DetectorConstruction(double alongSlitTranslation, double verticalStagger);
+  DetectorConstruction(double alongSlitTranslation, double verticalStagger,
+                       TrackingChamberFactory::LevelOfDetail tcLevelOfDetail =
+                           TrackingChamberFactory::LevelOfDetail::kDetailed);
   ~DetectorConstruction() override;
 
+  /// Setup position used by the following Construct()
+  void setSetupTranslation(double alongSlitTranslation,
+                           double verticalStagger);
+
   G4VPhysicalVolume* Construct() override;
   void ConstructSDandField() override;
 
@@ -29,6 +40,21 @@ class DetectorConstruction : public G4VUserDetectorConstruction {
   double translation;
   double stagger;
   double angle;
+
+  /// Chip (x, y, rotation) misalignments, the geometry
+  /// constants unless overridden before Construct()
+  std::unordered_map<int, std::tuple<double, double, double>>
+      tc1ChipAlignmentPars;
+  std::unordered_map<int, std::tuple<double, double, double>>
+      tc2ChipAlignmentPars;
+
+  TrackingChamberFactory::LevelOfDetail tcDetail;
+  VacuumChamberFactory::SolidModel vcSolidModel =
+      VacuumChamberFactory::SolidModel::kBoolean;
+
+  /// The second stage of the phase-space simulation
+  /// starts behind the vacuum chamber
+  bool constructVacuumChamber = true;
 };
 
 #endif
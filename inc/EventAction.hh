@@ -0,0 +1,31 @@
+#ifndef EventAction_h
+#define EventAction_h
+
+#include "G4UserEventAction.hh"
+
+class G4Event;
+class MemoryMonitor;
+class ProgressReporter;
+
+/// Brackets the tracking of every event for the performance counters
+/// and the memory monitor, and passes its hits to the progress reporter
+class EventAction : public G4UserEventAction {
+ public:
+  EventAction() = default;
+  ~EventAction() override = default;
+
+  void BeginOfEventAction(const G4Event* event) override;
+  void EndOfEventAction(const G4Event* event) override;
+
+  void setProgressReporter(ProgressReporter* progress) {
+    m_progress = progress;
+  }
+
+  void setMemoryMonitor(MemoryMonitor* memory) { m_memory = memory; }
+
+ private:
+  ProgressReporter* m_progress = nullptr;
+  MemoryMonitor* m_memory = nullptr;
+};
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef EventInformation_h
+#define EventInformation_h
+
+#include <vector>
+
+#include "G4VUserEventInformation.hh"
+
+/// Generator level information recorded with the hits
+class EventInformation : public G4VUserEventInformation {
+ public:
+  EventInformation() = default;
+  ~EventInformation() override = default;
+
+  void Print() const override;
+
+  /// Event weight, 1 unless the event is down-weighted; with several
+  /// primaries the product of their weights
+  double weight = 1;
+
+  /// The primary fails the acceptance pre-filter and
+  /// is simulated only for the bias estimate
+  bool outsideAcceptance = false;
+
+  /// Generated energy and angles of the primaries, in the order
+  /// of their vertices, for the offline reweighting
+  std::vector<double> primaryE;
+  std::vector<double> primaryTheta;
+  std::vector<double> primaryPhi;
+
+  /// Weight of every primary, nominal over proposal density; empty
+  /// if the event weight is the one of its single primary
+  std::vector<double> primaryWeight;
+
+  /// Stage one track and parent ids of the primaries replayed from a
+  /// phase-space file, in the order of their vertices; empty for the
+  /// other generators, whose primaries are the beam particles
+  std::vector<int> originTrackId;
+  std::vector<int> originParentTrackId;
+};
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef EventRootSink_h
+#define EventRootSink_h
+
+#include <vector>
+
+#include "RootSink.hh"
+
+/// One tree entry per event instead of per pixel: eventId, runId,
+/// eventWeight and the primaries once, the pixels and their hits as
+/// flat arrays. The hits of pixel p are [pixelHitOffset[p],
+/// pixelHitOffset[p + 1]) of the hit arrays, pixelHitOffset has one
+/// element more than the pixels. Hit i comes from primary
+/// primaryIdx[i] of weight primaryWeight[primaryIdx[i]]. The vectors
+/// of the pixel layout are split into one array per component, e.g.
+/// hitPosGlobalX/Y/Z.
+///
+/// The events are buffered until endEvent(), the file, compression and
+/// basket settings are those of RootSink; compactPrecision is ignored
+class EventRootSink : public RootSink {
+ public:
+  EventRootSink(const std::string& filePath, const std::string& treeName,
+                const PixelRecord& record, const Config& cfg);
+  ~EventRootSink() override;
+
+  /// Appends the pixel to the event
+  void write() override;
+  void endEvent() override;
+
+  /// Writes the event left open, if any
+  void close(const Metadata& metadata) override;
+
+ private:
+  const PixelRecord& m_record;
+
+  // --- Pixels
+  std::vector<int> m_geoId;
+  std::vector<int> m_pixIdX;
+  std::vector<int> m_pixIdY;
+  std::vector<int> m_isSignal;
+  std::vector<double> m_geoCenterLocal[2];
+  std::vector<double> m_geoCenterGlobal[3];
+  std::vector<double> m_totEDep;
+  std::vector<int> m_pixelHitOffset;
+
+  // --- Hits
+  std::vector<int> m_parentTrackId;
+  std::vector<int> m_trackId;
+  std::vector<int> m_primaryIdx;
+  std::vector<double> m_hitPosGlobal[3];
+  std::vector<double> m_hitPosLocal[2];
+  std::vector<double> m_hitEntryPosGlobal[3];
+  std::vector<double> m_hitMomDir[3];
+  std::vector<double> m_hitE;
+  std::vector<double> m_hitP;
+  std::vector<double> m_ipMomDir[3];
+  std::vector<double> m_ipE;
+  std::vector<double> m_ipP;
+  std::vector<double> m_vertex[3];
+  std::vector<double> m_eDep;
+  std::vector<int> m_pdgId;
+};
+
+#endif
@@ -84,6 +84,10 @@ struct GeometryConstants {
   /// Bounding box parameters
   const G4double vcRad = vcFlangeCenterZ + vcFlangeHalfZ;
 
+  /// Largest deviation of the polygon chords from
+  /// the wall arcs in the native solids model
+  const G4double vcArcTolerance = 10 * um;
+
   /// --------------------------------------------------------------
   /// Dipole magnet
 
@@ -280,6 +284,10 @@ struct GeometryConstants {
   const G4double tc1CenterZ =
       vcCenterZ + vcRad + tc1VaccumChamberDistance + tcHalfZ;
 
+  /// Phase-space scoring plane between the VC flange and TC1
+  const G4double phaseSpacePlaneZ =
+      vcCenterZ + vcRad + tc1VaccumChamberDistance / 2.0;
+
   const G4double tc1RotationAngleX = 0;
   const G4double tc1RotationAngleY = 0;
   const G4double tc1RotationAngleZ = M_PI_2;
@@ -0,0 +1,46 @@
+#ifndef HitPrecisionReader_h
+#define HitPrecisionReader_h
+
+#include <cstddef>
+#include <vector>
+
+#include "TTree.h"
+#include "TVector2.h"
+#include "TVector3.h"
+
+/// Reads hitPosLocal, hitMomDir and vertex of the pixel tree of
+/// RootSink in either precision. The compact arrays of nHits are
+/// decoded with RootSink::offsetQuantum and RootSink::directionScale,
+/// the full precision vectors are read as written
+class HitPrecisionReader {
+ public:
+  /// Sets the addresses of the branches of tree, which must outlive
+  /// the reader
+  explicit HitPrecisionReader(TTree& tree);
+  HitPrecisionReader(const HitPrecisionReader&) = delete;
+  HitPrecisionReader& operator=(const HitPrecisionReader&) = delete;
+
+  /// The tree has the nHits branch of compactPrecision
+  bool compact() const { return m_compact; }
+
+  /// Hit i of the entry read last; the compact offset is relative to
+  /// the pixel center geoCenterLocal
+  TVector2 hitPosLocal(std::size_t i, const TVector2& geoCenterLocal) const;
+  TVector3 hitMomDir(std::size_t i) const;
+  TVector3 vertex(std::size_t i) const;
+
+ private:
+  bool m_compact = false;
+
+  // --- Full precision
+  std::vector<TVector2>* m_hitPosLocal = nullptr;
+  std::vector<TVector3>* m_hitMomDir = nullptr;
+  std::vector<TVector3>* m_vertex = nullptr;
+
+  // --- Compact precision, sized for the largest nHits of the tree
+  std::vector<Short_t> m_hitOffsetLocal[2];
+  std::vector<Short_t> m_hitMomDirComponents[3];
+  std::vector<double> m_vertexComponents[3];
+};
+
+#endif
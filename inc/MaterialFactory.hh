@@ -133,6 +133,8 @@ class MaterialFactory {
 
   void constructPBT();
 
+  bool m_constructed = false;
+
  protected:
   static MaterialFactory* m_instance;
 };
@@ -0,0 +1,66 @@
+#ifndef MemoryMonitor_h
+#define MemoryMonitor_h
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+class Run;
+
+/// Memory footprint of the job: the RSS after every startup stage
+/// (geometry and physics list, physics tables), the peak RSS and the
+/// largest RSS growth over one event, the SamplingHit pool and the
+/// unwritten output buffers of the sink. Reported every
+/// reportEvery events and at the end of every run.
+///
+/// Above the budget the output buffers are written out at the end of
+/// the event, as long as they hold at least minFlushBytes; smaller
+/// flushes would only fragment the file
+class MemoryMonitor {
+ public:
+  struct Config {
+    /// Events between two reports, 0 for the end of run only
+    std::uint64_t reportEvery = 100000;
+
+    /// RSS in bytes that triggers the output flushing, 0 for none
+    std::uint64_t budget = 0;
+
+    std::uint64_t minFlushBytes = 1 << 20;
+  };
+
+  explicit MemoryMonitor(const Config& cfg);
+  ~MemoryMonitor();
+
+  /// RSS now, credited to the stage since the previous record
+  void recordStartup(const std::string& stage);
+
+  void beginRun(Run* run);
+  void endRun();
+  void beginEvent();
+  void endEvent(int eventId);
+
+  /// Resident set size of the process in bytes
+  std::uint64_t residentBytes() const;
+
+ private:
+  void report(const char* title) const;
+
+  Config m_cfg;
+  int m_statmFd = -1;
+  long m_pageSize;
+
+  std::vector<std::pair<std::string, std::uint64_t>> m_startup;
+  bool m_tablesRecorded = false;
+
+  Run* m_run = nullptr;
+  std::uint64_t m_events = 0;
+  std::uint64_t m_eventStartRss = 0;
+  std::uint64_t m_peakRss = 0;
+  std::uint64_t m_maxEventGrowth = 0;
+  int m_maxGrowthEventId = -1;
+  std::uint64_t m_flushes = 0;
+  bool m_budgetWarned = false;
+};
+
+#endif
@@ -0,0 +1,79 @@
+#ifndef MomentumTable_h
+#define MomentumTable_h
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/// Density of the measured (px, py, pz) momenta as an adaptive
+/// histogram: the momenta are split recursively at the median of
+/// their widest coordinate until a bin holds at most maxEntriesPerBin
+/// of them. A momentum is sampled in O(1) by picking a bin with the
+/// alias method and a point uniformly in its bounding box.
+///
+/// The table is built once from the text file and stored in a binary
+/// cache, which is reused as long as the source file and the binning
+/// configuration are unchanged. Files larger than maxSamples momenta
+/// are reservoir sampled.
+class MomentumTable {
+ public:
+  struct Config {
+    /// "px,py,pz" per line, electron mass units
+    std::string sourcePath;
+
+    /// Binary table, built if missing or out of date
+    std::string cachePath;
+
+    std::size_t maxEntriesPerBin = 64;
+
+    std::size_t maxSamples = 20000000;
+
+    /// Seed of the reservoir sampling
+    std::uint64_t seed = 1;
+  };
+
+  explicit MomentumTable(const Config& cfg);
+  ~MomentumTable() = default;
+
+  /// Draw (px, py, pz) in electron mass units
+  void sample(std::mt19937& rng, double momentum[3]) const;
+
+  bool valid() const { return !m_prob.empty(); }
+  bool fromCache() const { return m_fromCache; }
+  std::size_t nBins() const { return m_prob.size(); }
+
+  /// Momenta the table was built from
+  std::uint64_t nSamples() const { return m_nSamples; }
+
+ private:
+  /// Identifies the source file and the binning in the cache
+  struct Key {
+    std::uint64_t sourceSize;
+    std::int64_t sourceTime;
+    std::uint64_t maxEntriesPerBin;
+    std::uint64_t maxSamples;
+    std::uint64_t seed;
+
+    bool operator==(const Key&) const = default;
+  };
+
+  Key makeKey() const;
+  bool load(const Key& key);
+  void build();
+  void store(const Key& key) const;
+
+  Config m_cfg;
+  bool m_fromCache = false;
+  std::uint64_t m_nSamples = 0;
+
+  // Bin bounding boxes, 3 values per bin
+  std::vector<double> m_lower;
+  std::vector<double> m_upper;
+
+  // Vose alias table
+  std::vector<double> m_prob;
+  std::vector<std::uint32_t> m_alias;
+};
+
+#endif
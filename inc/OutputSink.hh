@@ -0,0 +1,145 @@
+#ifndef OutputSink_h
+#define OutputSink_h
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "TVector2.h"
+#include "TVector3.h"
+
+/// Fired pixel as recorded by Run, with its hits in the vectors
+struct PixelRecord {
+  int geoId;
+  int pixIdX;
+  int pixIdY;
+
+  int isSignal;
+
+  TVector2 geoCenterLocal;
+  TVector3 geoCenterGlobal;
+
+  double totEDep;
+
+  std::vector<int> parentTrackId;
+  std::vector<int> trackId;
+  std::vector<int> primaryIdx;
+  int eventId;
+  int runId;
+
+  /// Product of the weights of all primaries of the event, for event
+  /// level quantities such as the occupancy of a frame. Quantities of
+  /// single primaries, e.g. the signal efficiency or a hit spectrum,
+  /// take hitPrimaryWeight
+  double eventWeight;
+
+  /// Energy, angles and weight of the primaries of the event in the
+  /// order of their vertices. Written once per event by the event
+  /// layout only, the pixel layouts carry them per hit
+  std::vector<double> primaryE;
+  std::vector<double> primaryTheta;
+  std::vector<double> primaryPhi;
+  std::vector<double> primaryWeight;
+
+  std::vector<TVector3> hitPosGlobal;
+  std::vector<TVector2> hitPosLocal;
+  std::vector<TVector3> hitEntryPosGlobal;
+
+  std::vector<TVector3> hitMomDir;
+  std::vector<double> hitE;
+  std::vector<double> hitP;
+
+  std::vector<TVector3> ipMomDir;
+  std::vector<double> ipE;
+  std::vector<double> ipP;
+  std::vector<TVector3> vertex;
+
+  std::vector<double> eDep;
+  std::vector<int> pdgId;
+
+  /// Primary of primaryIdx of every hit. The kinematics are 0 where
+  /// the generator does not record them, the weight is then the event
+  /// weight
+  std::vector<double> hitPrimaryE;
+  std::vector<double> hitPrimaryTheta;
+  std::vector<double> hitPrimaryPhi;
+  std::vector<double> hitPrimaryWeight;
+};
+
+/// Destination of the pixel records of one run. A sink is bound to
+/// the record it writes at construction, write() appends its current
+/// content and endEvent() follows the last pixel of an event. The
+/// metadata is written once, on close
+class OutputSink {
+ public:
+  /// ROOT tree with one entry per pixel or per event (EventRootSink),
+  /// binary record stream (PixelStream.hh), RNTuple or nothing.
+  /// RNTuple needs ROOT 6.36 or later
+  enum class Format { kRoot, kRootEvents, kBinary, kRNTuple, kNull };
+
+  struct Config {
+    Format format = Format::kRoot;
+
+    /// ROOT compression, algorithm * 100 + level as from
+    /// ROOT::CompressionSettings, -1 for the default of the format
+    int compression = -1;
+
+    /// Tree: buffer size of the basket of every branch
+    int basketBytes = 32000;
+
+    /// Tree: TTree::SetAutoFlush and SetAutoSave, entries if positive,
+    /// bytes written if negative; the defaults are those of ROOT
+    std::int64_t autoFlush = -30000000;
+    std::int64_t autoSave = -300000000;
+
+    /// Tree: hitPosLocal, hitMomDir and vertex in reduced precision,
+    /// see RootSink; the pixel layout only
+    bool compactPrecision = false;
+
+    /// RNTuple: compressed size a cluster is flushed at
+    std::uint64_t clusterBytes = 128 << 20;
+
+    /// RNTuple: uncompressed size a page of a column grows to
+    std::uint64_t pageBytes = 1 << 20;
+  };
+
+  using Metadata = std::vector<std::pair<std::string, double>>;
+
+  virtual ~OutputSink() = default;
+
+  virtual void write() = 0;
+
+  /// Ends the event of the records written since the previous call,
+  /// called only for events with records
+  virtual void endEvent() {}
+
+  virtual void close(const Metadata& metadata) = 0;
+
+  /// Bytes held in memory and not yet written to the file
+  virtual std::uint64_t bufferedBytes() const { return 0; }
+
+  /// Writes the buffers to the file, freeing them
+  virtual void flush() {}
+
+  static std::unique_ptr<OutputSink> create(const Config& cfg,
+                                            const std::string& filePath,
+                                            const std::string& treeName,
+                                            const PixelRecord& record);
+
+  /// Format from its command line name: root, root-events, binary,
+  /// rntuple, null.
+  /// No format for rntuple where ROOT does not support it
+  static std::optional<Format> formatFromName(const std::string& name);
+
+  /// Compression from its command line name, algorithm and optional
+  /// level: none, zlib, lzma, lz4, zstd, e.g. zstd:7
+  static std::optional<int> compressionFromName(const std::string& name);
+
+  /// File name extension of the format, empty for the null sink
+  static std::string extension(Format format);
+};
+
+#endif
@@ -0,0 +1,106 @@
+#ifndef PerfCounters_h
+#define PerfCounters_h
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/// Cycles, instructions, cache misses and branch misses per
+/// simulation phase and thread, from perf_event_open, plus the CPU
+/// time of the thread. The phases nest: while a phase is entered the
+/// counts of the enclosing one are paused, so every count belongs to
+/// exactly one phase. The counters are read in user space with rdpmc
+/// where the kernel allows it, with read() otherwise.
+///
+/// Disabled, which is the default, a phase hook costs one relaxed
+/// load. Without access to the hardware counters (virtual machines,
+/// perf_event_paranoid > 2) only the CPU time is reported
+class PerfCounters {
+ public:
+  enum class Phase {
+    kOther,
+    kGeneration,
+    kTracking,
+    kSensitiveDetector,
+    kRecordEvent,
+    kOutput
+  };
+  static constexpr int kNumPhases = 6;
+
+  enum Counter { kCycles, kInstructions, kCacheMisses, kBranchMisses };
+  static constexpr int kNumCounters = 4;
+
+  struct Totals {
+    std::uint64_t counts[kNumCounters] = {0, 0, 0, 0};
+    double cpuSeconds = 0;
+    std::uint64_t entries = 0;
+  };
+
+  /// The threads open their counters when they first enter a phase
+  static void enable() { s_enabled.store(true, std::memory_order_relaxed); }
+  static bool enabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+  /// Zeroes the totals of all threads; call while they are idle
+  static void resetAll();
+
+  /// Totals per thread and phase to G4cout
+  static void report();
+
+  static void push(Phase phase) {
+    if (enabled()) {
+      forThread().enter(phase);
+    }
+  }
+
+  static void pop() {
+    if (enabled()) {
+      forThread().leave();
+    }
+  }
+
+  /// Counts the enclosed code to phase
+  class Scope {
+   public:
+    explicit Scope(Phase phase) { push(phase); }
+    ~Scope() { pop(); }
+
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+  };
+
+  ~PerfCounters();
+
+ private:
+  struct Snapshot {
+    std::uint64_t counts[kNumCounters];
+    double cpuSeconds;
+  };
+
+  PerfCounters();
+
+  /// Counters of the calling thread, opened on first use
+  static PerfCounters& forThread();
+
+  void enter(Phase phase);
+  void leave();
+
+  /// Adds the counts since the last checkpoint to the current phase
+  void checkpoint();
+  void read(Snapshot& snapshot) const;
+  bool readUser(int counter, std::uint64_t& value) const;
+
+  static inline std::atomic<bool> s_enabled{false};
+
+  int m_threadIdx = 0;
+  bool m_hardware = false;
+
+  // Group led by the cycles, -1 for the counters that failed to open
+  int m_fds[kNumCounters] = {-1, -1, -1, -1};
+  void* m_pages[kNumCounters] = {nullptr, nullptr, nullptr, nullptr};
+
+  std::vector<Phase> m_stack;
+  Snapshot m_last;
+  Totals m_totals[kNumPhases];
+};
+
+#endif
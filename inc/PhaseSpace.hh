@@ -0,0 +1,62 @@
+#ifndef PhaseSpace_h
+#define PhaseSpace_h
+
+#include <cstdint>
+
+/// Binary phase-space file written behind the vacuum chamber
+/// flange by the first simulation stage and replayed as primaries
+/// by the second one. A Header is followed by Records, the records
+/// of a stage one event are consecutive. Little endian, no padding.
+namespace PhaseSpace {
+
+constexpr char magic[4] = {'A', 'L', 'P', 'S'};
+constexpr std::uint32_t version = 2;
+
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+
+  /// Global z of the scoring plane [mm]
+  double planeZ;
+
+  /// Stage one events, for the normalization
+  std::uint64_t nEvents;
+
+  /// Stage one events with at least one record
+  std::uint64_t nStoredEvents;
+
+  std::uint64_t nRecords;
+};
+
+/// Particle crossing the plane in the forward direction
+struct Record {
+  std::uint32_t eventId;
+  std::int32_t pdgId;
+
+  /// Stage one track id, 1 for the beam particle
+  std::int32_t trackId;
+
+  /// Stage one parent track id, 0 for the beam particle
+  std::int32_t parentTrackId;
+
+  /// Position on the plane [mm]
+  float x;
+  float y;
+
+  /// Direction, the z component is positive
+  float dirX;
+  float dirY;
+
+  /// Kinetic energy [MeV]
+  float eKin;
+
+  /// Global time [ns]
+  float time;
+};
+
+static_assert(sizeof(Header) == 40);
+static_assert(sizeof(Record) == 40);
+
+}  // namespace PhaseSpace
+
+#endif
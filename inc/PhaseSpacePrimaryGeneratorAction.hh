@@ -0,0 +1,47 @@
+#ifndef PhaseSpacePrimaryGeneratorAction_h
+#define PhaseSpacePrimaryGeneratorAction_h
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "G4Event.hh"
+#include "G4ParticleGun.hh"
+#include "G4VUserPrimaryGeneratorAction.hh"
+#include "PhaseSpace.hh"
+
+class G4ParticleGun;
+class G4Event;
+
+/// Second simulation stage. Every event replays the particles
+/// of one stored first stage event, the beam particle first.
+/// The replayed particles start on the scoring plane: in stage two
+/// the vertex, ipE, ipP and ipMomDir branches describe the plane
+/// crossing, not the interaction point
+class PhaseSpacePrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
+ public:
+  PhaseSpacePrimaryGeneratorAction(const std::string& path);
+  ~PhaseSpacePrimaryGeneratorAction() override = default;
+
+  void GeneratePrimaries(G4Event* event) override;
+
+  const PhaseSpace::Header& header() const { return m_header; }
+
+  /// Restart from the first stored event
+  void rewind();
+
+ private:
+  /// Read the records of the next stored event
+  bool readEvent();
+
+  std::ifstream m_file;
+  PhaseSpace::Header m_header;
+
+  std::vector<PhaseSpace::Record> m_event;
+  PhaseSpace::Record m_next;
+  bool m_hasNext = false;
+
+  G4ParticleGun* m_particleGun = nullptr;
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef PhaseSpaceScorer_h
+#define PhaseSpaceScorer_h
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "G4UserSteppingAction.hh"
+#include "PhaseSpace.hh"
+
+class G4Step;
+
+/// First simulation stage. Records every particle crossing the
+/// plane z = planeZ in the forward direction and stops it there
+class PhaseSpaceScorer : public G4UserSteppingAction {
+ public:
+  PhaseSpaceScorer(const std::string& filePath, double planeZ);
+  ~PhaseSpaceScorer() override;
+
+  void UserSteppingAction(const G4Step* step) override;
+
+ private:
+  void flush();
+
+  std::ofstream m_file;
+  PhaseSpace::Header m_header;
+  std::vector<PhaseSpace::Record> m_buffer;
+
+  int m_lastEventId = -1;
+  int m_lastStoredEventId = -1;
+};
+
+#endif
@@ -0,0 +1,90 @@
+#ifndef Philox_h
+#define Philox_h
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/// Philox4x32-10 counter-based generator (Salmon et al., SC11).
+/// Every (key, counter) pair gives four independent 32 bit words,
+/// so a stream can be split across threads or events by counter
+/// without shared state
+namespace Philox {
+
+using Counter = std::array<std::uint32_t, 4>;
+using Key = std::array<std::uint32_t, 2>;
+
+constexpr std::uint32_t multiplier0 = 0xD2511F53;
+constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+constexpr std::uint32_t weyl0 = 0x9E3779B9;
+constexpr std::uint32_t weyl1 = 0xBB67AE85;
+
+constexpr Counter generate(Counter counter, Key key) {
+  for (int round = 0; round < 10; round++) {
+    std::uint64_t product0 =
+        static_cast<std::uint64_t>(multiplier0) * counter[0];
+    std::uint64_t product1 =
+        static_cast<std::uint64_t>(multiplier1) * counter[2];
+    counter = {static_cast<std::uint32_t>(product1 >> 32) ^ counter[1] ^
+                   key[0],
+               static_cast<std::uint32_t>(product1),
+               static_cast<std::uint32_t>(product0 >> 32) ^ counter[3] ^
+                   key[1],
+               static_cast<std::uint32_t>(product0)};
+    key[0] += weyl0;
+    key[1] += weyl1;
+  }
+  return counter;
+}
+
+/// Word by word, the == of std::array is constexpr only from C++20
+constexpr bool equal(const Counter& a, const Counter& b) {
+  return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+}
+
+// Known answers of Random123 (kat_vectors, philox4x32 10 rounds)
+static_assert(equal(generate({0, 0, 0, 0}, {0, 0}),
+                    {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+static_assert(equal(generate({0xffffffff, 0xffffffff, 0xffffffff,
+                              0xffffffff},
+                             {0xffffffff, 0xffffffff}),
+                    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+static_assert(equal(generate({0x243f6a88, 0x85a308d3, 0x13198a2e,
+                              0x03707344},
+                             {0xa4093822, 0x299f31d0}),
+                    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+
+/// Uniform double in the open interval (0, 1) from 53 random bits
+inline double toUniform(std::uint32_t hi, std::uint32_t lo) {
+  std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 21) ^ (lo >> 11);
+  return (bits + 0.5) * 0x1.0p-53;
+}
+
+/// Fills out[0, n) with the uniforms of the stream (key, stream),
+/// two per counter. The counters are independent, so the loop
+/// has no carried state
+inline void fillUniforms(Key key, std::uint64_t stream, double* out,
+                         std::size_t n) {
+  auto streamLo = static_cast<std::uint32_t>(stream);
+  auto streamHi = static_cast<std::uint32_t>(stream >> 32);
+  for (std::size_t i = 0; i < n / 2; i++) {
+    Counter words = generate(
+        {static_cast<std::uint32_t>(i), 0, streamLo, streamHi}, key);
+    out[2 * i] = toUniform(words[0], words[1]);
+    out[2 * i + 1] = toUniform(words[2], words[3]);
+  }
+  if (n % 2 != 0) {
+    Counter words = generate(
+        {static_cast<std::uint32_t>(n / 2), 0, streamLo, streamHi}, key);
+    out[n - 1] = toUniform(words[0], words[1]);
+  }
+}
+
+inline Key makeKey(std::uint64_t seed) {
+  return {static_cast<std::uint32_t>(seed),
+          static_cast<std::uint32_t>(seed >> 32)};
+}
+
+}  // namespace Philox
+
+#endif
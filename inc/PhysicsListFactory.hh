@@ -0,0 +1,44 @@
+#ifndef PhysicsListFactory_h
+#define PhysicsListFactory_h
+
+#include <optional>
+#include <string>
+
+#include "G4Types.hh"
+#include "G4VModularPhysicsList.hh"
+
+class PhysicsListFactory {
+ public:
+  /// Reference hadronic list or electromagnetic only lists.
+  /// The beam primaries are ~1 GeV electrons, for which the
+  /// hadronic tables of FTFP_BERT are mostly start-up cost
+  enum class Model { kFtfpBert, kEmStandard, kEmStandardOpt3, kEmStandardOpt4 };
+
+  struct Config {
+    /// Physics list
+    Model model;
+
+    /// Add the gamma-nuclear and electro-nuclear processes
+    /// to the electromagnetic only lists
+    G4bool gammaNuclear;
+
+    /// Register G4StepLimiterPhysics
+    G4bool stepLimiter;
+
+    /// Physics list verbosity
+    G4int verbose;
+  };
+
+  PhysicsListFactory() = default;
+  ~PhysicsListFactory() = default;
+
+  G4VModularPhysicsList* construct(const Config& cfg);
+
+  /// Model from its command line name: FTFP_BERT, EM0, EM3, EM4
+  static std::optional<Model> modelFromName(const std::string& name);
+
+  /// Unique name of the configuration, e.g. EM4+GN
+  static std::string name(const Config& cfg);
+};
+
+#endif
@@ -0,0 +1,55 @@
+#ifndef PhysicsTableCache_h
+#define PhysicsTableCache_h
+
+#include <string>
+
+#include "G4VUserPhysicsList.hh"
+
+/// Stores the physics tables built by the first job in a cache
+/// directory and retrieves them in the following jobs. The tables
+/// of a configuration live in a subdirectory named after the hash
+/// of the physics list name, the production cuts and the materials.
+///
+/// Usage:
+///   runManager->Initialize();
+///   cache.retrieve(physicsList);
+///   runManager->BeamOn(0);
+///   cache.store(physicsList);
+class PhysicsTableCache {
+ public:
+  struct Config {
+    /// Cache root directory
+    std::string cacheDir;
+
+    /// Physics list name, e.g. PhysicsListFactory::name()
+    std::string physicsListName;
+  };
+
+  explicit PhysicsTableCache(const Config& cfg);
+  ~PhysicsTableCache() = default;
+
+  /// Request the retrieval of the cached tables if they exist.
+  /// Call after the geometry and the materials are constructed
+  /// and before the first run builds the tables
+  G4bool retrieve(G4VUserPhysicsList* physicsList);
+
+  /// Store the tables if they were not retrieved. Call after
+  /// the first run has built them
+  G4bool store(G4VUserPhysicsList* physicsList);
+
+  /// Tables directory of the current configuration
+  const std::string& directory() const { return m_directory; }
+
+ private:
+  /// Description of everything the tables depend on
+  std::string describe(const G4VUserPhysicsList* physicsList) const;
+
+  void update(const G4VUserPhysicsList* physicsList);
+
+  Config m_cfg;
+  std::string m_key;
+  std::string m_directory;
+  G4bool m_retrieving = false;
+};
+
+#endif
@@ -0,0 +1,49 @@
+#ifndef PixelGeometry_h
+#define PixelGeometry_h
+
+#include "G4RotationMatrix.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4TwoVector.hh"
+
+/// ALPIDE pixel maths shared by the sensitive detector and the
+/// offline reprocessing. The origin and the rotation are those
+/// of the touchable of the sensitive volume
+namespace PixelGeometry {
+
+constexpr double pixelX = 29.24 * um;
+constexpr double pixelY = 26.88 * um;
+
+constexpr double chipX = 29.94176 * mm;
+constexpr double chipY = 13.762560 * mm;
+
+constexpr int nPixelsX = 1024;
+constexpr int nPixelsY = 512;
+
+/// Electron-hole pair creation energy in silicon, turns the deposit
+/// of a pixel into electrons for the threshold
+constexpr double pairProductionE = 3.62 * eV;
+
+inline G4ThreeVector toLocal(const G4ThreeVector& global,
+                             const G4ThreeVector& origin,
+                             const G4RotationMatrix& rotation) {
+  return rotation.inverse() * (global - origin);
+}
+
+inline G4ThreeVector toGlobal(const G4ThreeVector& local,
+                              const G4ThreeVector& origin,
+                              const G4RotationMatrix& rotation) {
+  return rotation * local + origin;
+}
+
+inline int pixelIdX(double localX) { return (localX + chipX / 2.0) / pixelX; }
+inline int pixelIdY(double localY) { return (localY + chipY / 2.0) / pixelY; }
+
+inline G4TwoVector pixelCenter(int pixIdX, int pixIdY) {
+  return G4TwoVector((pixIdX + 0.5) * pixelX - chipX / 2.0,
+                     (pixIdY + 0.5) * pixelY - chipY / 2.0);
+}
+
+}  // namespace PixelGeometry
+
+#endif
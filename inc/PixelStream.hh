@@ -0,0 +1,92 @@
+#ifndef PixelStream_h
+#define PixelStream_h
+
+#include <cstdint>
+
+/// Append-only binary output of the pixel records, the fast,
+/// uncompressed streaming alternative to the ROOT tree: the doubles
+/// are written as they are, so a file is several times larger than
+/// the compressed tree. A Header is followed by blocks, each starting
+/// with its kind and size in bytes so that readers can skip the ones
+/// they do not know. A pixel block is a Pixel followed by its nHits
+/// Hits; the Metadata blocks come last, when the run is closed.
+/// Little endian, no padding, the units of the ROOT tree.
+namespace PixelStream {
+
+constexpr char magic[4] = {'A', 'L', 'P', 'X'};
+constexpr std::uint32_t version = 2;
+
+enum Kind : std::uint32_t { kPixel = 1, kMetadata = 2 };
+
+struct Header {
+  char magic[4];
+  std::uint32_t version;
+};
+
+struct Pixel {
+  std::uint32_t kind;
+
+  /// Including the hits
+  std::uint32_t nBytes;
+
+  std::int32_t eventId;
+  std::int32_t runId;
+  std::int32_t geoId;
+  std::int32_t pixIdX;
+  std::int32_t pixIdY;
+  std::int32_t isSignal;
+  std::uint32_t nHits;
+
+  /// Zero, aligns the doubles
+  std::uint32_t reserved;
+
+  /// Product of the primary weights, see PixelRecord
+  double eventWeight;
+  double totEDep;
+  double geoCenterLocal[2];
+  double geoCenterGlobal[3];
+};
+
+struct Hit {
+  std::int32_t trackId;
+  std::int32_t parentTrackId;
+  std::int32_t primaryIdx;
+  std::int32_t pdgId;
+
+  double eDep;
+  double e;
+  double p;
+  double ipE;
+  double ipP;
+
+  double posGlobal[3];
+  double posLocal[2];
+  double entryPosGlobal[3];
+  double momDir[3];
+  double ipMomDir[3];
+  double vertex[3];
+
+  /// Primary of primaryIdx, see PixelRecord
+  double primaryE;
+  double primaryTheta;
+  double primaryPhi;
+  double primaryWeight;
+};
+
+struct Metadata {
+  std::uint32_t kind;
+  std::uint32_t nBytes;
+
+  /// Zero terminated
+  char name[56];
+  double value;
+};
+
+static_assert(sizeof(Header) == 8);
+static_assert(sizeof(Pixel) == 96);
+static_assert(sizeof(Hit) == 224);
+static_assert(sizeof(Metadata) == 72);
+
+}  // namespace PixelStream
+
+#endif
@@ -0,0 +1,23 @@
+#ifndef PlacementWalker_h
+#define PlacementWalker_h
+
+#include <functional>
+
+#include "G4RotationMatrix.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+
+/// Called for every placement with the rotation and the translation
+/// taking its local frame to the global one. Returning false skips
+/// the daughters of the volume
+using PlacementVisitor =
+    std::function<bool(const G4VPhysicalVolume* volume,
+                       const G4RotationMatrix& rotation,
+                       const G4ThreeVector& translation)>;
+
+/// Depth first walk of the placements below and including world,
+/// composing the transforms the way the navigator does
+void walkPlacements(const G4VPhysicalVolume* world,
+                    const PlacementVisitor& visitor);
+
+#endif
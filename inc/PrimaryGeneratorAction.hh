@@ -1,11 +1,12 @@
 #ifndef GeneratorAction_h
 #define GeneratorAction_h
 
-#include <random>
+#include <cstdint>
 
 #include "G4Event.hh"
 #include "G4ParticleGun.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
+#include "PrimarySampler.hh"
 
 class G4ParticleGun;
 class G4Event;
@@ -19,14 +20,34 @@ class PrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
 
   void GeneratePrimaries(G4Event* event) override;
 
+  /// Replace the clock based seed, e.g. for reproducible benchmarks
+  void setSeed(std::uint64_t seed) { m_sampler.setSeed(seed); }
+
+  /// kPhilox draws the primaries of every event from its own
+  /// counter-based stream, selected by the event id
+  void setRandomEngine(PrimarySampler::Engine engine) {
+    m_sampler.setEngine(engine);
+  }
+
+  /// Draw from a wider proposal, the event weight restores the
+  /// nominal beam
+  void setProposal(PrimarySampler::EnergyProposal energyProposal,
+                   double angleProposalScale) {
+    m_sampler.setProposal(energyProposal, angleProposalScale);
+  }
+
+  const PrimarySampler::Config& samplerConfig() const {
+    return m_sampler.config();
+  }
+
+  /// Replace the electrons, e.g. by geantinos for navigation studies
+  void setParticle(const G4String& particleName);
+
  private:
   int m_nParticles;
-  double m_particleEnergyMin;
-  double m_particleEnergyMax;
-  double m_sigmaTheta;
-  double m_sigmaPhi;
 
-  std::mt19937 m_rng;
+  PrimarySampler m_sampler;
+  PrimarySampler::Block m_block;
 
   G4ParticleDefinition* m_particle = nullptr;
   G4ParticleGun* m_particleGun = nullptr;
@@ -0,0 +1,20 @@
+#ifndef PrimaryIndexTrackingAction_h
+#define PrimaryIndexTrackingAction_h
+
+#include "G4UserTrackingAction.hh"
+
+class G4Track;
+
+/// Tags every track with the index of its primary. The primaries
+/// get the track ids 1..K in the order of their vertices, the
+/// secondaries inherit the index of their parent
+class PrimaryIndexTrackingAction : public G4UserTrackingAction {
+ public:
+  PrimaryIndexTrackingAction() = default;
+  ~PrimaryIndexTrackingAction() override = default;
+
+  void PreUserTrackingAction(const G4Track* track) override;
+  void PostUserTrackingAction(const G4Track* track) override;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PrimarySampler_h
+#define PrimarySampler_h
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+/// Energies and angles of the PrimaryGeneratorAction beam, drawn in
+/// blocks of one event. The Mersenne twister engine draws them one
+/// by one from a single stream. The Philox engine makes every event a
+/// function of the seed and the event id only: it draws all uniforms
+/// of the event at once and transforms them with Box-Muller in flat
+/// loops that the compiler can vectorise.
+///
+/// The nominal beam is flat in energy with Gaussian angles. The
+/// primaries can be drawn from a wider proposal instead, each with
+/// the weight nominal / proposal density
+class PrimarySampler {
+ public:
+  enum class Engine { kMersenneTwister, kPhilox };
+
+  enum class EnergyProposal { kFlat, kLogFlat };
+
+  struct Config {
+    double energyMin;
+    double energyMax;
+    double sigmaTheta;
+    double sigmaPhi;
+
+    Engine engine = Engine::kMersenneTwister;
+
+    std::uint64_t seed = 0;
+
+    /// kLogFlat oversamples the low energies
+    EnergyProposal energyProposal = EnergyProposal::kFlat;
+
+    /// Width of the proposal angle Gaussians in units of sigmaTheta
+    /// and sigmaPhi, above 1 oversamples the tails
+    double angleProposalScale = 1;
+  };
+
+  /// Primaries of one event in structure of arrays layout
+  struct Block {
+    std::vector<double> energy;
+    std::vector<double> theta;
+    std::vector<double> phi;
+
+    /// Nominal over proposal density
+    std::vector<double> weight;
+
+    std::size_t size() const { return energy.size(); }
+  };
+
+  explicit PrimarySampler(const Config& cfg);
+
+  void setSeed(std::uint64_t seed);
+  void setEngine(Engine engine) { m_cfg.engine = engine; }
+  void setProposal(EnergyProposal energyProposal, double angleProposalScale) {
+    m_cfg.energyProposal = energyProposal;
+    m_cfg.angleProposalScale = angleProposalScale;
+  }
+
+  const Config& config() const { return m_cfg; }
+
+  /// Densities of a primary, for the offline reweighting. Directions
+  /// with sigma 0 and a fixed energy contribute the factor 1
+  double nominalDensity(double energy, double theta, double phi) const;
+  double proposalDensity(double energy, double theta, double phi) const;
+
+  /// Factors of the nominal density, for targets that replace one
+  double nominalEnergyDensity(double energy) const;
+  double nominalAngleDensity(double theta, double phi) const;
+
+  /// Draw n primaries; the event id selects the Philox stream and
+  /// is ignored by the Mersenne twister
+  void sample(std::uint64_t eventId, std::size_t n, Block& block);
+
+ private:
+  void sampleMersenneTwister(std::size_t n, Block& block);
+  void samplePhilox(std::uint64_t eventId, std::size_t n, Block& block);
+
+  /// Energy of the proposal at the cumulative probability u
+  double proposalEnergy(double u) const;
+  void computeWeights(Block& block) const;
+
+  Config m_cfg;
+
+  std::mt19937 m_rng;
+
+  std::vector<double> m_uniforms;
+};
+
+#endif
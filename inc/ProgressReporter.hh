@@ -0,0 +1,75 @@
+#ifndef ProgressReporter_h
+#define ProgressReporter_h
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// Progress of long batch runs. The event path only adds to relaxed
+/// atomic counters of the calling thread; a reporting thread samples
+/// them every interval and prints the events processed, the rolling
+/// events/s per thread, the hits/s, the output size, the RSS and the
+/// ETA to stderr, and rewrites the same as JSON to the status file
+class ProgressReporter {
+ public:
+  struct Config {
+    /// Seconds between two reports
+    double interval = 60;
+
+    /// Latest report as JSON, none if empty
+    std::string statusPath;
+  };
+
+  explicit ProgressReporter(const Config& cfg);
+  ~ProgressReporter();
+
+  /// Starts reporting a run of nEvents writing to outputPath
+  void start(int runId, std::uint64_t nEvents, const std::string& outputPath);
+
+  /// Stops the reporting thread after a final report
+  void stop();
+
+  void eventDone(std::uint64_t nHits) {
+    Slot& slot = m_slots[slotIndex()];
+    slot.events.fetch_add(1, std::memory_order_relaxed);
+    slot.hits.fetch_add(nHits, std::memory_order_relaxed);
+  }
+
+ private:
+  static constexpr std::size_t kMaxSlots = 64;
+
+  struct alignas(64) Slot {
+    std::atomic<std::uint64_t> events{0};
+    std::atomic<std::uint64_t> hits{0};
+  };
+
+  /// Master or sequential thread first, then the workers
+  static std::size_t slotIndex();
+
+  void loop();
+  void report(bool finished);
+
+  Config m_cfg;
+  std::array<Slot, kMaxSlots> m_slots;
+
+  int m_runId = 0;
+  std::uint64_t m_nEvents = 0;
+  std::string m_outputPath;
+
+  std::thread m_thread;
+  std::mutex m_mutex;
+  std::condition_variable m_wake;
+  bool m_stopping = false;
+
+  // Previous sample, for the rolling rates
+  double m_startTime = 0;
+  double m_lastTime = 0;
+  std::array<std::uint64_t, kMaxSlots> m_lastEvents{};
+  std::uint64_t m_lastHits = 0;
+};
+
+#endif
@@ -0,0 +1,70 @@
+#ifndef RNTupleSink_h
+#define RNTupleSink_h
+
+#ifdef WITH_RNTUPLE
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "OutputSink.hh"
+
+/// The pixel records as an RNTuple with the fields and names of the
+/// tree branches. The 2- and 3-vectors are typed std::array<double>
+/// fields, so the hit vectors need no dictionary and are split into
+/// one column per component.
+///
+/// The sinks of the worker threads writing to the same file share one
+/// parallel writer, each filling its own clusters. The metadata is
+/// written next to the RNTuple by the sink that closes last, the
+/// master run after merging the worker runs
+class RNTupleSink : public OutputSink {
+ public:
+  RNTupleSink(const std::string& filePath, const std::string& ntupleName,
+              const PixelRecord& record, const Config& cfg);
+  ~RNTupleSink() override;
+
+  void write() override;
+  void close(const Metadata& metadata) override;
+
+  /// Uncompressed bytes filled into the open cluster of this sink
+  std::uint64_t bufferedBytes() const override { return m_clusterBytes; }
+  /// Writes the pages of the open cluster; the cluster size bounds
+  /// the buffers otherwise
+  void flush() override;
+
+ private:
+  struct Writer;
+  struct FillState;
+
+  /// Calls f(name, pointer) for every field, in the branch order
+  template <typename F>
+  void forEachField(F&& f);
+
+  // Writers of the open files by path
+  static std::mutex s_writersMutex;
+  static std::map<std::string, std::shared_ptr<Writer>> s_writers;
+
+  std::string m_filePath;
+  const PixelRecord& m_record;
+  std::shared_ptr<Writer> m_writer;
+  std::unique_ptr<FillState> m_fill;
+  std::uint64_t m_clusterBytes = 0;
+
+  // Components of the TVector2 and TVector3 of the record
+  std::array<double, 2> m_geoCenterLocal;
+  std::array<double, 3> m_geoCenterGlobal;
+  std::vector<std::array<double, 3>> m_hitPosGlobal;
+  std::vector<std::array<double, 2>> m_hitPosLocal;
+  std::vector<std::array<double, 3>> m_hitEntryPosGlobal;
+  std::vector<std::array<double, 3>> m_hitMomDir;
+  std::vector<std::array<double, 3>> m_ipMomDir;
+  std::vector<std::array<double, 3>> m_vertex;
+};
+
+#endif
+
+#endif
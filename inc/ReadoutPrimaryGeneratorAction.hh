@@ -8,6 +8,9 @@
 #include "G4ParticleGun.hh"
 #include "G4VUserPrimaryGeneratorAction.hh"
 
+class AcceptanceFilter;
+class MomentumTable;
+
 class G4ParticleGun;
 class G4Event;
 
@@ -18,13 +21,48 @@ class ReadoutPrimaryGeneratorAction : public G4VUserPrimaryGeneratorAction {
 
   void GeneratePrimaries(G4Event* event) override;
 
+  /// Restart from the first momentum in the file, or
+  /// from the first sampled momentum of the table
+  void rewind();
+
+  /// Fixed seed of the table sampling instead of the clock
+  void setSeed(std::mt19937::result_type seed) {
+    m_seed = seed;
+    m_rng.seed(m_seed);
+  }
+
+  /// Sample the momenta from the table instead of reading the file,
+  /// the number of events is then unlimited
+  void setMomentumTable(const MomentumTable* table) {
+    m_momentumTable = table;
+  }
+
+  /// Skip or down-weight the momenta outside the acceptance
+  void setAcceptanceFilter(AcceptanceFilter* filter) {
+    m_acceptanceFilter = filter;
+  }
+
+  /// Pack K primaries into every event to share the per-event costs
+  void setPrimariesPerEvent(int primariesPerEvent) {
+    m_primariesPerEvent = primariesPerEvent;
+  }
+
  private:
+  /// Read the next (px, py, pz) in electron mass units
+  bool readMomentum(double& px, double& py, double& pz);
+
   std::ifstream m_file;
 
   std::mt19937 m_rng;
+  std::mt19937::result_type m_seed;
 
   G4ParticleDefinition* m_particle = nullptr;
   G4ParticleGun* m_particleGun = nullptr;
+
+  AcceptanceFilter* m_acceptanceFilter = nullptr;
+  const MomentumTable* m_momentumTable = nullptr;
+
+  int m_primariesPerEvent = 1;
 };
 
 #endif
@@ -0,0 +1,66 @@
+#ifndef RootSink_h
+#define RootSink_h
+
+#include <vector>
+
+#include "OutputSink.hh"
+#include "TBranch.h"
+#include "TFile.h"
+#include "TTree.h"
+
+/// One tree entry per pixel, the metadata as TParameter<double>
+/// next to the tree. The compression, basket size and AutoFlush and
+/// AutoSave policies come from the Config.
+///
+/// With compactPrecision the hitPosLocal, hitMomDir and vertex
+/// branches are replaced by arrays of nHits components:
+///  - hitOffsetLocalX/Y, Short_t: hitPosLocal - geoCenterLocal in
+///    units of offsetQuantum, i.e. 1 nm; the hits lie in their pixel
+///  - hitMomDirX/Y/Z, Short_t: the direction times directionScale
+///  - vertexX/Y/Z, Double32_t: stored as float
+class RootSink : public OutputSink {
+ public:
+  /// [mm]
+  static constexpr double offsetQuantum = 1e-6;
+  static constexpr double directionScale = 32767;
+
+  RootSink(const std::string& filePath, const std::string& treeName,
+           const PixelRecord& record, const Config& cfg);
+  ~RootSink() override;
+
+  void write() override;
+  void close(const Metadata& metadata) override;
+
+  /// Buffers of the baskets being filled
+  std::uint64_t bufferedBytes() const override;
+  void flush() override;
+
+ protected:
+  /// Opens the file and an empty tree with the settings of cfg, for
+  /// the layouts of the derived sinks
+  RootSink(const std::string& filePath, const std::string& treeName,
+           const Config& cfg);
+
+  TTree* m_tree = nullptr;
+
+ private:
+  /// The arrays of the compact branches, refilled on every write
+  struct CompactBranch {
+    TBranch* branch;
+    std::vector<Short_t> shorts;
+    std::vector<Double32_t> doubles;
+  };
+
+  void fillCompact();
+
+  TFile* m_file = nullptr;
+
+  const PixelRecord* m_record = nullptr;
+  bool m_compact = false;
+  int m_nHits = 0;
+  CompactBranch m_hitOffsetLocal[2];
+  CompactBranch m_hitMomDir[3];
+  CompactBranch m_vertex[3];
+};
+
+#endif
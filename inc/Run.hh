@@ -1,59 +1,51 @@
 #ifndef Run_h
 #define Run_h
 
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "G4Run.hh"
-#include "G4SystemOfUnits.hh"
-#include "TFile.h"
-#include "TTree.h"
-#include "TVector2.h"
-#include "TVector3.h"
+#include "OutputSink.hh"
 
+/// One output record per fired pixel, written by the sink of
+/// outputCfg. A pixel fires when its summed deposit reaches
+/// pixelThreshold electrons. An empty filePath selects the null sink
+/// like kNull does
 class Run : public G4Run {
  public:
   Run(const std::string& filePath, const std::string& treeName,
-      double pixelThreshold);
+      double pixelThreshold, const OutputSink::Config& outputCfg = {});
   ~Run() override;
 
   void RecordEvent(const G4Event*) override;
   void Merge(const G4Run*) override;
 
- private:
-  TFile* m_file = nullptr;
-  TTree* m_tree = nullptr;
-
-  int m_geoId;
-  int m_pixIdX;
-  int m_pixIdY;
-
-  int m_isSignal;
-
-  TVector2 m_geoCenterLocal;
-  TVector3 m_geoCenterGlobal;
+  /// Written by the sink when the run is closed. The numberOfEvents
+  /// and weightedEventsWithHits counters of the run are written only
+  /// if not added before, e.g. by a tool reprocessing a run
+  void addMetadata(const std::string& name, double value);
 
-  double m_totEDep;
+  /// Output held in memory, e.g. the baskets of the tree
+  std::uint64_t bufferedBytes() const;
 
-  std::vector<int> m_parentTrackId;
-  std::vector<int> m_trackId;
-  int m_eventId;
-  int m_runId;
+  /// Writes the buffered output to the file, freeing it
+  void flushOutput();
 
-  std::vector<TVector3> m_hitPosGlobal;
-  std::vector<TVector2> m_hitPosLocal;
-
-  std::vector<TVector3> m_hitMomDir;
-  std::vector<double> m_hitE;
-  std::vector<double> m_hitP;
+ private:
+  PixelRecord m_record;
+  std::unique_ptr<OutputSink> m_sink;
 
-  std::vector<TVector3> m_ipMomDir;
-  std::vector<double> m_ipE;
-  std::vector<double> m_ipP;
-  std::vector<TVector3> m_vertex;
+  /// [electrons]
+  double m_pixelThreshold;
 
-  std::vector<double> m_eDep;
-  std::vector<int> m_pdgId;
+  /// Summed weights of the events with pixels, inside and
+  /// outside the acceptance of the pre-filter
+  double m_weightedEventsWithHits[2] = {0, 0};
 
-  double m_pairProductionE = 3.62 * eV;
-  double m_pixelThreshold;
+  std::vector<std::pair<std::string, double>> m_metadata;
 };
 
 #endif
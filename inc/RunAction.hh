@@ -1,10 +1,19 @@
 #ifndef RunAction_h
 #define RunAction_h
 
+#include <string>
+#include <utility>
+#include <vector>
+
 #include "G4Run.hh"
 #include "G4UserRunAction.hh"
+#include "OutputSink.hh"
 
+class AcceptanceFilter;
 class G4Run;
+class MemoryMonitor;
+class Profiler;
+class ProgressReporter;
 
 class RunAction : public G4UserRunAction {
  public:
@@ -16,10 +25,53 @@ class RunAction : public G4UserRunAction {
   void EndOfRunAction(const G4Run* run) override;
   G4Run* GenerateRun() override;
 
+  /// Output file of the following runs
+  void setFilePath(const std::string& filePath) { m_filePath = filePath; }
+
+  /// Sink of the following runs, ROOT by default
+  void setOutputConfig(const OutputSink::Config& cfg) { m_outputCfg = cfg; }
+
+  /// Filter updated for the geometry of every run,
+  /// its counts are stored with the run output
+  void setAcceptanceFilter(AcceptanceFilter* filter) {
+    m_acceptanceFilter = filter;
+  }
+
+  /// Stored with the output of every following run,
+  /// e.g. the generator configuration
+  void addMetadata(const std::string& name, double value) {
+    m_metadata.emplace_back(name, value);
+  }
+
+  /// Reset at the start of every run and reported at its end
+  void setProfiler(Profiler* profiler) { m_profiler = profiler; }
+
+  /// Started at the beginning of every run and stopped at its end
+  void setProgressReporter(ProgressReporter* progress) {
+    m_progress = progress;
+  }
+
+  /// Follows the output of every run and reports at its end
+  void setMemoryMonitor(MemoryMonitor* memory) { m_memory = memory; }
+
+  /// Stored with the run output to count the simulated primaries
+  void setPrimariesPerEvent(int primariesPerEvent) {
+    m_primariesPerEvent = primariesPerEvent;
+  }
+
  private:
   std::string m_filePath;
   std::string m_treeName;
   double m_pixelThreshold;
+  OutputSink::Config m_outputCfg;
+
+  AcceptanceFilter* m_acceptanceFilter = nullptr;
+  Profiler* m_profiler = nullptr;
+  ProgressReporter* m_progress = nullptr;
+  MemoryMonitor* m_memory = nullptr;
+  int m_primariesPerEvent = 1;
+
+  std::vector<std::pair<std::string, double>> m_metadata;
 };
 
 #endif
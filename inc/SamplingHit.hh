@@ -35,12 +35,14 @@ class SamplingHit : public G4VHit {
   void SetParentTrackId(int id) { m_parentTrackId = id; };
   void SetTrackId(int id) { m_trackId = id; };
   void SetPdgId(int id) { m_pdgId = id; };
+  void SetPrimaryIdx(int idx) { m_primaryIdx = idx; };
 
   void SetPixCenterGlobal(G4ThreeVector xyz) { m_pixCenterGlobal = xyz; };
   void SetPixCenterLocal(G4TwoVector xy) { m_pixCenterLocal = xy; };
 
   void SetHitPosGlobal(G4ThreeVector xyz) { m_hitPosGlobal = xyz; };
   void SetHitPosLocal(G4TwoVector xy) { m_hitPosLocal = xy; };
+  void SetHitEntryPosGlobal(G4ThreeVector xyz) { m_hitEntryPosGlobal = xyz; };
   void SetVertex(G4ThreeVector xyz) { m_vertex = xyz; };
 
   void SetMomDir(G4ThreeVector xyz) { m_momDir = xyz; };
@@ -60,12 +62,14 @@ class SamplingHit : public G4VHit {
   int GetParentTrackId() const { return m_parentTrackId; };
   int GetTrackId() const { return m_trackId; };
   int GetPdgId() const { return m_pdgId; };
+  int GetPrimaryIdx() const { return m_primaryIdx; };
 
   G4ThreeVector GetPixCenterGlobal() const { return m_pixCenterGlobal; };
   G4TwoVector GetPixCenterLocal() const { return m_pixCenterLocal; };
 
   G4ThreeVector GetHitPosGlobal() const { return m_hitPosGlobal; };
   G4TwoVector GetHitPosLocal() const { return m_hitPosLocal; };
+  G4ThreeVector GetHitEntryPosGlobal() const { return m_hitEntryPosGlobal; };
   G4ThreeVector GetVertex() const { return m_vertex; };
 
   G4ThreeVector GetMomDir() const { return m_momDir; };
@@ -86,12 +90,14 @@ class SamplingHit : public G4VHit {
   int m_parentTrackId = -1;
   int m_trackId = -1;
   int m_pdgId = -1;
+  int m_primaryIdx = 0;
 
   G4ThreeVector m_pixCenterGlobal;
   G4TwoVector m_pixCenterLocal;
 
   G4ThreeVector m_hitPosGlobal;
   G4TwoVector m_hitPosLocal;
+  G4ThreeVector m_hitEntryPosGlobal;
   G4ThreeVector m_vertex;
 
   G4ThreeVector m_momDir;
@@ -108,13 +114,24 @@ using TrackerHitsCollection = G4THitsCollection<SamplingHit>;
 
 extern G4ThreadLocal G4Allocator<SamplingHit>* TrackerHitAllocator;
 
+/// Hits alive in the pool of the thread and their maximum
+struct SamplingHitPoolStats {
+  std::size_t live = 0;
+  std::size_t highWater = 0;
+};
+
+extern G4ThreadLocal SamplingHitPoolStats TrackerHitPoolStats;
+
 inline void* SamplingHit::operator new(size_t) {
   if (!TrackerHitAllocator)
     TrackerHitAllocator = new G4Allocator<SamplingHit>;
+  if (++TrackerHitPoolStats.live > TrackerHitPoolStats.highWater)
+    TrackerHitPoolStats.highWater = TrackerHitPoolStats.live;
   return (void*)TrackerHitAllocator->MallocSingle();
 }
 
 inline void SamplingHit::operator delete(void* hit) {
+  TrackerHitPoolStats.live--;
   TrackerHitAllocator->FreeSingle((SamplingHit*)hit);
 }
 
@@ -21,12 +21,6 @@ class SamplingVolume : public G4VSensitiveDetector {
  private:
   std::string m_indexedVolumeName;
 
-  const double m_pixelX = 29.24 * um;
-  const double m_pixelY = 26.88 * um;
-
-  const double m_chipX = 29.94176 * mm;
-  const double m_chipY = 13.762560 * mm;
-
   TrackerHitsCollection* m_hitsCollection = nullptr;
 };
 
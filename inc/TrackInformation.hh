@@ -0,0 +1,18 @@
+#ifndef TrackInformation_h
+#define TrackInformation_h
+
+#include "G4VUserTrackInformation.hh"
+
+/// Primary a track descends from, for events with several primaries
+class TrackInformation : public G4VUserTrackInformation {
+ public:
+  explicit TrackInformation(int primaryIdx) : primaryIdx(primaryIdx) {}
+  ~TrackInformation() override = default;
+
+  void Print() const override;
+
+  /// Position of the primary in the event, from 0
+  int primaryIdx;
+};
+
+#endif
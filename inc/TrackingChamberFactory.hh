@@ -1,9 +1,16 @@
 #ifndef TrackingChamberFactory_h
 #define TrackingChamberFactory_h
 
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "G4AssemblyVolume.hh"
 #include "G4LogicalBorderSurface.hh"
 #include "G4RunManager.hh"
+#include "G4ThreeVector.hh"
 #include "G4Types.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VSolid.hh"
@@ -11,10 +18,16 @@
 #include "GeometryConstants.hh"
 
 class G4LogicalVolume;
+class G4Material;
 class G4PhysicalVolume;
 
 class TrackingChamberFactory {
  public:
+  /// Level of detail of the passive parts. The fast mode replaces
+  /// the LDO boxes, the nine chip PCB connectors and the PCIe
+  /// connectors by boxes of the same mass, the sensors are exact
+  enum class LevelOfDetail { kDetailed, kFast };
+
   struct Config {
     /// TC namespace
     std::string name;
@@ -39,6 +52,9 @@ class TrackingChamberFactory {
     std::unordered_map<int, std::tuple<double, double, double>>
         chipAlignmentPars;
 
+    /// Level of detail of the passive parts
+    LevelOfDetail levelOfDetail;
+
     /// Check overlaps flag
     G4bool checkOverlaps;
   };
@@ -49,14 +65,43 @@ class TrackingChamberFactory {
   G4VPhysicalVolume *construct(G4LogicalVolume *logicParent, const Config &cfg);
 
  private:
+  /// Drop the shared volumes if they were built for different constants
+  void resetSharedVolumes(const Config &cfg);
+
+  /// Return the shared logical volume with the given name,
+  /// building it on the first request
+  G4LogicalVolume *findOrBuild(const std::string &name,
+                               const std::function<G4LogicalVolume *()> &build);
+
   G4LogicalVolume *constructSensor(const Config &cfg, int geometryId);
 
   G4LogicalVolume *constructLConnector(const Config &cfg);
 
   G4AssemblyVolume *constructNineAlpidePCB(const Config &cfg);
 
+  G4LogicalVolume *constructPcieConnector(const Config &cfg);
+
+  void placePcieConnector(const Config &cfg, G4LogicalVolume *logicParent,
+                          const G4ThreeVector &position,
+                          const std::string &name, int copyNo);
+
+  /// Box filled with the given (material, volume) components
+  /// smeared to a uniform density. Keeps the mass and the
+  /// radiation length in g/cm2 of the parts it replaces
+  G4LogicalVolume *constructHomogenizedBox(
+      const std::string &name, G4double x, G4double y, G4double z,
+      const std::vector<std::pair<G4Material *, G4double>> &components);
+
   G4LogicalVolume *constructCarrierPCB(G4double &carrierPcbContainerY,
                                        const Config &cfg, int nCarrier);
+
+  /// Logical volumes identical in all the chambers built by this
+  /// factory. Only the aligned sensors and the containers holding
+  /// them are constructed per chamber.
+  const GeometryConstants *m_sharedGc = nullptr;
+  LevelOfDetail m_sharedLevelOfDetail = LevelOfDetail::kDetailed;
+  std::unordered_map<std::string, G4LogicalVolume *> m_sharedVolumes;
+  G4AssemblyVolume *m_nineChipPcbAssembly = nullptr;
 };
 
 #endif
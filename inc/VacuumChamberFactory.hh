@@ -1,8 +1,11 @@
 #ifndef VacuumChamberFactory_h
 #define VacuumChamberFactory_h
 
+#include <vector>
+
 #include "G4LogicalBorderSurface.hh"
 #include "G4RunManager.hh"
+#include "G4TwoVector.hh"
 #include "G4Types.hh"
 #include "G4VPhysicalVolume.hh"
 #include "G4VSolid.hh"
@@ -14,6 +17,11 @@ class G4PhysicalVolume;
 
 class VacuumChamberFactory {
  public:
+  /// Solids the chamber is built from. The native model replaces
+  /// the boolean solids by G4Tubs, G4Box and G4ExtrudedSolid pieces
+  /// and by placed vacuum daughters for the door and flange cutouts
+  enum class SolidModel { kBoolean, kNative };
+
   struct Config {
     /// VC instance name
     std::string name;
@@ -31,6 +39,9 @@ class VacuumChamberFactory {
     /// VC parameters
     const GeometryConstants *gc;
 
+    /// Solids the chamber is built from
+    SolidModel solidModel;
+
     bool checkOverlaps;
   };
 
@@ -47,6 +58,15 @@ class VacuumChamberFactory {
   std::pair<G4VSolid *, G4VSolid *> constructVcWindows(const Config &cfg);
 
   std::pair<G4VSolid *, G4VSolid *> constructVcFlange(const Config &cfg);
+
+  G4VPhysicalVolume *constructNative(G4LogicalVolume *logicParent,
+                                     const Config &cfg);
+
+  /// Wall cross section between two neighbouring exits
+  std::vector<G4TwoVector> constructWallPillarPolygon(const Config &cfg);
+
+  /// Wall cross section above and below an exit door
+  std::vector<G4TwoVector> constructWallLintelPolygon(const Config &cfg);
 };
 
 #endif
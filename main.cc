@@ -1,12 +1,33 @@
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <sstream>
 #include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
 
+#include "AcceptanceFilter.hh"
 #include "DetectorConstruction.hh"
-#include "FTFP_BERT.hh"
+#include "EventAction.hh"
 #include "G4RunManager.hh"
-#include "G4StepLimiterPhysics.hh"
 #include "G4SystemOfUnits.hh"
+#include "G4Timer.hh"
 #include "G4UImanager.hh"
+#include "G4ios.hh"
+#include "GeometryConstants.hh"
+#include "MemoryMonitor.hh"
+#include "MomentumTable.hh"
+#include "OutputSink.hh"
+#include "PerfCounters.hh"
+#include "PhaseSpacePrimaryGeneratorAction.hh"
+#include "PhaseSpaceScorer.hh"
+#include "PhysicsListFactory.hh"
+#include "PhysicsTableCache.hh"
 #include "PrimaryGeneratorAction.hh"
+#include "PrimaryIndexTrackingAction.hh"
+#include "Profiler.hh"
+#include "ProgressReporter.hh"
 #include "ReadoutPrimaryGeneratorAction.hh"
 #include "RunAction.hh"
 
@@ -22,6 +43,24 @@
 #include "G4UIExecutive.hh"
 #endif
 
+// Scan points, one "alongSlitTranslation verticalStagger" pair
+// in mm per line, # starts a comment
+std::vector<std::pair<double, double>> readScanPoints(
+    const std::string &path) {
+  std::vector<std::pair<double, double>> points;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream stream(line);
+    double translation, stagger;
+    if (stream >> translation >> stagger) {
+      points.emplace_back(translation * mm, stagger * mm);
+    }
+  }
+  return points;
+}
+
 int main(int argc, char *argv[]) {
   int noe = 82584690;
   // int noe = 1e5;
@@ -33,33 +72,374 @@ int main(int argc, char *argv[]) {
   // int noe = std::stoi(argv[1]);
   // int nParticles = std::stoi(argv[2]);
 
-  // double particleEnergyMin = std::stod(argv[3]) / 1e1 * GeV;
-  // double particleEnergyMax = std::stod(argv[3]) / 1e1 * GeV;
-
   double sigmaPhi = 0.035 * rad;
   double sigmaTheta = 0.035 * rad;
 
+  double alongSlitTranslation = 0 * mm;
+  double verticalStagger = 0 * mm;
+  double pixelThreshold = 0;
+
+  auto tcDetail = TrackingChamberFactory::LevelOfDetail::kDetailed;
+  auto vcSolidModel = VacuumChamberFactory::SolidModel::kBoolean;
+  PhysicsListFactory::Config physicsCfg{
+      .model = PhysicsListFactory::Model::kFtfpBert,
+      .gammaNuclear = false,
+      .stepLimiter = true,
+      .verbose = 1};
+  std::string physicsCacheDir;
+  std::vector<std::pair<double, double>> scanPoints;
+  std::string phaseSpaceOutput;
+  std::string phaseSpaceInput;
+  bool eventsSet = false;
+  std::unique_ptr<AcceptanceFilter> acceptanceFilter;
+  AcceptanceFilter::Config acceptanceCfg{
+      .margin = 0, .mode = AcceptanceFilter::Mode::kSkip, .keepFraction = 0};
+  bool filterAcceptance = false;
+  int primariesPerEvent = 1;
+  std::string momentumTablePath;
+  bool beamGenerator = false;
+  auto energyProposal = PrimarySampler::EnergyProposal::kFlat;
+  double angleProposalScale = 1;
+  auto randomEngine = PrimarySampler::Engine::kMersenneTwister;
+  bool randomEngineSet = false;
+  std::unique_ptr<Profiler> profiler;
+  Profiler::Config profilerCfg;
+  ProgressReporter::Config progressCfg;
+  bool reportProgress = false;
+  MemoryMonitor::Config memoryCfg;
+  bool monitorMemory = false;
+  OutputSink::Config outputCfg;
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--fast-geometry") {
+      tcDetail = TrackingChamberFactory::LevelOfDetail::kFast;
+    } else if (arg == "--native-vc") {
+      vcSolidModel = VacuumChamberFactory::SolidModel::kNative;
+    } else if (arg.rfind("--physics=", 0) == 0) {
+      auto model = PhysicsListFactory::modelFromName(arg.substr(10));
+      if (!model) {
+        G4cerr << "Unknown physics list " << arg.substr(10)
+               << ", expected FTFP_BERT, EM0, EM3 or EM4" << G4endl;
+        return 1;
+      }
+      physicsCfg.model = *model;
+    } else if (arg == "--gamma-nuclear") {
+      physicsCfg.gammaNuclear = true;
+    } else if (arg.rfind("--physics-cache=", 0) == 0) {
+      physicsCacheDir = arg.substr(16);
+    } else if (arg.rfind("--events=", 0) == 0) {
+      noe = std::stoi(arg.substr(9));
+      eventsSet = true;
+    } else if (arg.rfind("--scan=", 0) == 0) {
+      scanPoints = readScanPoints(arg.substr(7));
+      if (scanPoints.empty()) {
+        G4cerr << "No scan points in " << arg.substr(7) << G4endl;
+        return 1;
+      }
+      std::tie(alongSlitTranslation, verticalStagger) = scanPoints.front();
+    } else if (arg.rfind("--phase-space-write=", 0) == 0) {
+      phaseSpaceOutput = arg.substr(20);
+    } else if (arg.rfind("--phase-space-read=", 0) == 0) {
+      phaseSpaceInput = arg.substr(19);
+    } else if (arg.rfind("--acceptance-margin=", 0) == 0) {
+      acceptanceCfg.margin = std::stod(arg.substr(20)) * mm;
+      filterAcceptance = true;
+    } else if (arg.rfind("--acceptance-keep=", 0) == 0) {
+      acceptanceCfg.mode = AcceptanceFilter::Mode::kWeight;
+      acceptanceCfg.keepFraction = std::stod(arg.substr(18));
+      filterAcceptance = true;
+    } else if (arg.rfind("--primaries-per-event=", 0) == 0) {
+      primariesPerEvent = std::stoi(arg.substr(22));
+    } else if (arg.rfind("--momentum-table=", 0) == 0) {
+      momentumTablePath = arg.substr(17);
+    } else if (arg == "--beam") {
+      beamGenerator = true;
+    } else if (arg.rfind("--energy-min=", 0) == 0) {
+      particleEnergyMin = std::stod(arg.substr(13)) * GeV;
+    } else if (arg.rfind("--energy-max=", 0) == 0) {
+      particleEnergyMax = std::stod(arg.substr(13)) * GeV;
+    } else if (arg == "--energy-proposal=log") {
+      energyProposal = PrimarySampler::EnergyProposal::kLogFlat;
+    } else if (arg.rfind("--angle-proposal-scale=", 0) == 0) {
+      angleProposalScale = std::stod(arg.substr(23));
+    } else if (arg.rfind("--rng=", 0) == 0) {
+      if (arg.substr(6) == "philox") {
+        randomEngine = PrimarySampler::Engine::kPhilox;
+      } else if (arg.substr(6) == "mt19937") {
+        randomEngine = PrimarySampler::Engine::kMersenneTwister;
+      } else {
+        G4cerr << "Unknown random engine " << arg.substr(6)
+               << ", expected mt19937 or philox" << G4endl;
+        return 1;
+      }
+      randomEngineSet = true;
+    } else if (arg == "--profile") {
+      profiler = std::make_unique<Profiler>(profilerCfg);
+    } else if (arg.rfind("--profile-rows=", 0) == 0) {
+      profilerCfg.nRows = std::stoul(arg.substr(15));
+      profiler = std::make_unique<Profiler>(profilerCfg);
+    } else if (arg == "--perf-counters") {
+      PerfCounters::enable();
+    } else if (arg.rfind("--memory-report=", 0) == 0) {
+      memoryCfg.reportEvery = std::stoull(arg.substr(16));
+      monitorMemory = true;
+    } else if (arg.rfind("--memory-budget=", 0) == 0) {
+      memoryCfg.budget = std::stoull(arg.substr(16)) << 20;
+      monitorMemory = true;
+    } else if (arg.rfind("--output=", 0) == 0) {
+      auto format = OutputSink::formatFromName(arg.substr(9));
+      if (!format) {
+        G4cerr << "Unknown output " << arg.substr(9)
+               << ", expected root, root-events, binary, rntuple (ROOT "
+                  "6.36 or later) or null"
+               << G4endl;
+        return 1;
+      }
+      outputCfg.format = *format;
+    } else if (arg.rfind("--compression=", 0) == 0) {
+      auto compression = OutputSink::compressionFromName(arg.substr(14));
+      if (!compression) {
+        G4cerr << "Unknown compression " << arg.substr(14)
+               << ", expected none, zlib, lzma, lz4 or zstd with an "
+                  "optional :level from 1 to 9"
+               << G4endl;
+        return 1;
+      }
+      outputCfg.compression = *compression;
+    } else if (arg.rfind("--basket-size=", 0) == 0) {
+      outputCfg.basketBytes = std::stoi(arg.substr(14));
+    } else if (arg.rfind("--auto-flush=", 0) == 0) {
+      outputCfg.autoFlush = std::stoll(arg.substr(13));
+    } else if (arg.rfind("--auto-save=", 0) == 0) {
+      outputCfg.autoSave = std::stoll(arg.substr(12));
+    } else if (arg == "--compact-precision") {
+      outputCfg.compactPrecision = true;
+    } else if (arg.rfind("--rntuple-cluster=", 0) == 0) {
+      outputCfg.clusterBytes = std::stoull(arg.substr(18)) << 20;
+    } else if (arg.rfind("--rntuple-page=", 0) == 0) {
+      outputCfg.pageBytes = std::stoull(arg.substr(15)) << 10;
+    } else if (arg.rfind("--progress=", 0) == 0) {
+      progressCfg.interval = std::stod(arg.substr(11));
+      reportProgress = true;
+    } else if (arg.rfind("--progress-file=", 0) == 0) {
+      progressCfg.statusPath = arg.substr(16);
+      reportProgress = true;
+    } else {
+      G4cerr << "Unknown option " << arg << G4endl;
+      return 1;
+    }
+  }
+
+  if (physicsCfg.gammaNuclear &&
+      physicsCfg.model == PhysicsListFactory::Model::kFtfpBert) {
+    G4cerr << "--gamma-nuclear applies to the EM lists, FTFP_BERT already "
+              "has the gamma- and electro-nuclear processes"
+           << G4endl;
+    return 1;
+  }
+  if (!(particleEnergyMin >= 0 && particleEnergyMin <= particleEnergyMax)) {
+    G4cerr << "--energy-min and --energy-max need 0 <= min <= max" << G4endl;
+    return 1;
+  }
+  if (energyProposal == PrimarySampler::EnergyProposal::kLogFlat &&
+      !(particleEnergyMin > 0)) {
+    G4cerr << "--energy-proposal=log needs a positive minimum energy"
+           << G4endl;
+    return 1;
+  }
+  if (randomEngineSet && !beamGenerator) {
+    G4cerr << "--rng selects the engine of the --beam generator" << G4endl;
+    return 1;
+  }
+  if (filterAcceptance && (beamGenerator || !phaseSpaceInput.empty())) {
+    G4cerr << "--acceptance-* apply to the measured momenta, not to --beam "
+              "or --phase-space-read"
+           << G4endl;
+    return 1;
+  }
+  if (acceptanceCfg.mode == AcceptanceFilter::Mode::kWeight &&
+      !(acceptanceCfg.keepFraction > 0 && acceptanceCfg.keepFraction <= 1)) {
+    G4cerr << "--acceptance-keep needs a fraction in (0, 1]" << G4endl;
+    return 1;
+  }
+  if (primariesPerEvent < 1 ||
+      (primariesPerEvent > 1 &&
+       acceptanceCfg.mode == AcceptanceFilter::Mode::kWeight)) {
+    G4cerr << "--primaries-per-event needs a positive count and one primary "
+              "per event with --acceptance-keep"
+           << G4endl;
+    return 1;
+  }
+  if (outputCfg.compactPrecision &&
+      outputCfg.format != OutputSink::Format::kRoot) {
+    G4cerr << "--compact-precision applies to --output=root only" << G4endl;
+    return 1;
+  }
+  if (!(progressCfg.interval > 0)) {
+    G4cerr << "--progress needs a positive interval in seconds" << G4endl;
+    return 1;
+  }
+  // The default covers the whole primaries file
+  if (!eventsSet) {
+    noe = (noe + primariesPerEvent - 1) / primariesPerEvent;
+  }
+
   std::string filePath =
       // "particles.root";
       "/home/romanurmanov/work/Apollon/geant4_sims/al_window_flange/out_data/"
       "particles.root";
   std::string treeName = "particles";
+  std::string fileStem = filePath.substr(0, filePath.rfind(".root"));
+  filePath = fileStem + OutputSink::extension(outputCfg.format);
+  std::string momentumPath =
+      "/home/romanurmanov/work/Apollon/data/Xe_10^22_pxpypz.txt";
+
+  std::unique_ptr<MemoryMonitor> memory;
+  if (monitorMemory) {
+    memory = std::make_unique<MemoryMonitor>(memoryCfg);
+    memory->recordStartup("start");
+  }
 
   G4RunManager *runManager = new G4RunManager();
 
-  runManager->SetUserInitialization(new DetectorConstruction());
-  auto physicsList = new FTFP_BERT;
-  physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+  auto detector = new DetectorConstruction(alongSlitTranslation,
+                                           verticalStagger, tcDetail);
+  detector->vcSolidModel = vcSolidModel;
+  detector->constructVacuumChamber = phaseSpaceInput.empty();
+  runManager->SetUserInitialization(detector);
+  PhysicsListFactory physicsFactory;
+  auto physicsList = physicsFactory.construct(physicsCfg);
   runManager->SetUserInitialization(physicsList);
 
-  // runManager->SetUserAction(new PrimaryGeneratorAction(
-  //     nParticles, particleEnergyMin, particleEnergyMax, sigmaTheta,
-  //     sigmaPhi));
-  runManager->SetUserAction(new ReadoutPrimaryGeneratorAction(
-      "/home/romanurmanov/work/Apollon/data/Xe_10^22_pxpypz.txt"));
-  runManager->SetUserAction(new RunAction(filePath, treeName));
+  // Primaries from the beam model, the measured momenta or, in
+  // stage two, the stored particles
+  ReadoutPrimaryGeneratorAction *generator = nullptr;
+  PhaseSpacePrimaryGeneratorAction *phaseSpaceGenerator = nullptr;
+  PrimaryGeneratorAction *beam = nullptr;
+  std::unique_ptr<MomentumTable> momentumTable;
+  G4UserTrackingAction *trackingAction = nullptr;
+  G4UserSteppingAction *steppingAction = nullptr;
+  if (beamGenerator) {
+    beam = new PrimaryGeneratorAction(nParticles, particleEnergyMin,
+                                      particleEnergyMax, sigmaTheta, sigmaPhi);
+    beam->setProposal(energyProposal, angleProposalScale);
+    beam->setRandomEngine(randomEngine);
+    runManager->SetUserAction(beam);
+    if (nParticles > 1) {
+      trackingAction = new PrimaryIndexTrackingAction();
+    }
+  } else if (phaseSpaceInput.empty()) {
+    generator = new ReadoutPrimaryGeneratorAction(momentumPath);
+    if (!momentumTablePath.empty()) {
+      momentumTable = std::make_unique<MomentumTable>(MomentumTable::Config{
+          .sourcePath = momentumPath, .cachePath = momentumTablePath});
+      if (!momentumTable->valid()) {
+        G4cerr << "No momenta in " << momentumPath << " or "
+               << momentumTablePath << G4endl;
+        return 1;
+      }
+      generator->setMomentumTable(momentumTable.get());
+    }
+    generator->setPrimariesPerEvent(primariesPerEvent);
+    runManager->SetUserAction(generator);
+    if (primariesPerEvent > 1) {
+      trackingAction = new PrimaryIndexTrackingAction();
+    }
+  } else {
+    phaseSpaceGenerator = new PhaseSpacePrimaryGeneratorAction(phaseSpaceInput);
+    runManager->SetUserAction(phaseSpaceGenerator);
+    if (!eventsSet) {
+      noe = phaseSpaceGenerator->header().nStoredEvents;
+    }
+    G4cout << "Phase space " << phaseSpaceInput << ": "
+           << phaseSpaceGenerator->header().nStoredEvents << " of "
+           << phaseSpaceGenerator->header().nEvents << " events stored"
+           << G4endl;
+  }
+  if (!phaseSpaceOutput.empty()) {
+    steppingAction = new PhaseSpaceScorer(
+        phaseSpaceOutput, GeometryConstants::instance()->phaseSpacePlaneZ);
+  }
+  // Geant4 takes one action of each kind, the profiler wraps them
+  if (profiler) {
+    trackingAction = new ProfilingTrackingAction(*profiler, trackingAction);
+    steppingAction = new ProfilingSteppingAction(*profiler, steppingAction);
+  }
+  if (trackingAction != nullptr) {
+    runManager->SetUserAction(trackingAction);
+  }
+  if (steppingAction != nullptr) {
+    runManager->SetUserAction(steppingAction);
+  }
+  auto runAction = new RunAction(filePath, treeName, pixelThreshold);
+  runAction->setOutputConfig(outputCfg);
+  if (beam != nullptr) {
+    // Proposal of the event weights, for the offline reweighting
+    const PrimarySampler::Config &samplerCfg = beam->samplerConfig();
+    runAction->addMetadata("generatorEnergyMin", samplerCfg.energyMin);
+    runAction->addMetadata("generatorEnergyMax", samplerCfg.energyMax);
+    runAction->addMetadata("generatorSigmaTheta", samplerCfg.sigmaTheta);
+    runAction->addMetadata("generatorSigmaPhi", samplerCfg.sigmaPhi);
+    runAction->addMetadata(
+        "generatorEnergyProposal",
+        static_cast<double>(samplerCfg.energyProposal));
+    runAction->addMetadata("generatorAngleProposalScale",
+                           samplerCfg.angleProposalScale);
+    runAction->addMetadata("generatorEngine",
+                           static_cast<double>(samplerCfg.engine));
+  }
+  if (phaseSpaceGenerator != nullptr) {
+    // The stage one track ids of the primaries are not in the output
+    runAction->addMetadata("phaseSpaceReplay", 1);
+  }
+  if (beam != nullptr) {
+    runAction->setPrimariesPerEvent(nParticles);
+  } else if (generator != nullptr) {
+    runAction->setPrimariesPerEvent(primariesPerEvent);
+  }
+  runAction->setProfiler(profiler.get());
+  std::unique_ptr<ProgressReporter> progress;
+  if (reportProgress || PerfCounters::enabled() || memory) {
+    auto eventAction = new EventAction();
+    if (reportProgress) {
+      progress = std::make_unique<ProgressReporter>(progressCfg);
+      runAction->setProgressReporter(progress.get());
+      eventAction->setProgressReporter(progress.get());
+    }
+    if (memory) {
+      runAction->setMemoryMonitor(memory.get());
+      eventAction->setMemoryMonitor(memory.get());
+    }
+    runManager->SetUserAction(eventAction);
+  }
+  runManager->SetUserAction(runAction);
+  if (filterAcceptance && generator != nullptr) {
+    acceptanceFilter = std::make_unique<AcceptanceFilter>(acceptanceCfg);
+    generator->setAcceptanceFilter(acceptanceFilter.get());
+    runAction->setAcceptanceFilter(acceptanceFilter.get());
+  }
 
   runManager->Initialize();
+  if (memory) {
+    memory->recordStartup("geometry and physics list");
+  }
+
+  if (!physicsCacheDir.empty()) {
+    PhysicsTableCache cache(
+        {.cacheDir = physicsCacheDir,
+         .physicsListName = PhysicsListFactory::name(physicsCfg)});
+    cache.retrieve(physicsList);
+
+    // Builds or retrieves the tables without processing events
+    G4Timer timer;
+    timer.Start();
+    runManager->BeamOn(0);
+    timer.Stop();
+    G4cout << "Physics tables ready in " << timer.GetRealElapsed() << " s"
+           << G4endl;
+
+    cache.store(physicsList);
+  }
 
 #ifdef G4VIS_USE
   G4VisManager *visManager = new G4VisExecutive();
@@ -77,7 +457,35 @@ int main(int argc, char *argv[]) {
 
   delete uiEx;
 #else
-  runManager->BeamOn(noe);
+  if (scanPoints.empty()) {
+    runManager->BeamOn(noe);
+  }
+
+  // The physics tables and the primaries file are kept, only the
+  // geometry is rebuilt between the points
+  for (std::size_t i = 0; i < scanPoints.size(); i++) {
+    const auto &[translation, stagger] = scanPoints[i];
+    if (i > 0) {
+      detector->setSetupTranslation(translation, stagger);
+      runManager->ReinitializeGeometry(true);
+    }
+
+    char suffix[64];
+    std::snprintf(suffix, sizeof(suffix), "_t%.3f_s%.3f%s", translation / mm,
+                  stagger / mm,
+                  OutputSink::extension(outputCfg.format).c_str());
+    runAction->setFilePath(fileStem + suffix);
+    G4cout << "Scan point " << i << ": alongSlitTranslation "
+           << translation / mm << " mm, verticalStagger " << stagger / mm
+           << " mm -> " << fileStem + suffix << G4endl;
+
+    if (generator != nullptr) {
+      generator->rewind();
+    } else if (phaseSpaceGenerator != nullptr) {
+      phaseSpaceGenerator->rewind();
+    }
+    runManager->BeamOn(noe);
+  }
 #endif
 
 #ifdef G4VIS_USE
@@ -0,0 +1,170 @@
+#include "AcceptanceFilter.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "G4Box.hh"
+#include "G4FieldManager.hh"
+#include "G4LogicalVolume.hh"
+#include "G4PhysicalConstants.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4UniformMagField.hh"
+#include "G4VPhysicalVolume.hh"
+#include "PlacementWalker.hh"
+
+namespace {
+
+// Helix steps inside the field volume
+const double helixStep = 1 * mm;
+const int maxHelixSteps = 100000;
+
+// Length of the straight path after the field volume
+const double rayLength = 100 * m;
+
+}  // namespace
+
+AcceptanceFilter::AcceptanceFilter(const Config& cfg) : m_cfg(cfg) {}
+
+void AcceptanceFilter::update(const G4VPhysicalVolume* world) {
+  m_sensors.clear();
+  m_hasField = false;
+
+  walkPlacements(world, [&](const G4VPhysicalVolume* volume,
+                            const G4RotationMatrix& rotation,
+                            const G4ThreeVector& translation) {
+    const G4LogicalVolume* logic = volume->GetLogicalVolume();
+    const auto* box = dynamic_cast<const G4Box*>(logic->GetSolid());
+    if (box == nullptr) {
+      return true;
+    }
+    G4ThreeVector halfSize(box->GetXHalfLength(), box->GetYHalfLength(),
+                           box->GetZHalfLength());
+
+    if (logic->GetSensitiveDetector() != nullptr) {
+      m_sensors.push_back({translation, rotation, halfSize});
+      return false;
+    }
+
+    const G4FieldManager* fieldManager = logic->GetFieldManager();
+    if (fieldManager != nullptr && !m_hasField) {
+      const auto* field = dynamic_cast<const G4UniformMagField*>(
+          fieldManager->GetDetectorField());
+      if (field != nullptr) {
+        m_hasField = true;
+        m_fieldBox = {translation, rotation, halfSize};
+        m_field = field->GetConstantFieldValue();
+      }
+    }
+    return true;
+  });
+}
+
+bool AcceptanceFilter::hitsSensor(const G4ThreeVector& from,
+                                  const G4ThreeVector& to) const {
+  for (const Box& sensor : m_sensors) {
+    G4ThreeVector u = sensor.rotation.colX();
+    G4ThreeVector v = sensor.rotation.colY();
+    G4ThreeVector n = sensor.rotation.colZ();
+
+    double d0 = n.dot(from - sensor.center);
+    double d1 = n.dot(to - sensor.center);
+    if ((d0 > 0 && d1 > 0) || (d0 < 0 && d1 < 0) || d0 == d1) {
+      continue;
+    }
+    G4ThreeVector crossing = from + d0 / (d0 - d1) * (to - from);
+    G4ThreeVector offset = crossing - sensor.center;
+    if (std::abs(u.dot(offset)) <= sensor.halfSize.x() + m_cfg.margin &&
+        std::abs(v.dot(offset)) <= sensor.halfSize.y() + m_cfg.margin) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool AcceptanceFilter::accepts(const G4ThreeVector& position,
+                               const G4ThreeVector& momentum,
+                               double charge) const {
+  G4ThreeVector dir = momentum.unit();
+  if (!m_hasField || charge == 0) {
+    return hitsSensor(position, position + rayLength * dir);
+  }
+
+  // Entry into the field box, slab method in the box frame
+  G4RotationMatrix toBox = m_fieldBox.rotation.inverse();
+  G4ThreeVector localPos = toBox * (position - m_fieldBox.center);
+  G4ThreeVector localDir = toBox * dir;
+  double tEnter = 0;
+  double tExit = std::numeric_limits<double>::max();
+  for (int k = 0; k < 3; k++) {
+    double half = m_fieldBox.halfSize[k];
+    if (localDir[k] == 0) {
+      if (std::abs(localPos[k]) > half) {
+        tExit = -1;
+      }
+      continue;
+    }
+    double t0 = (-half - localPos[k]) / localDir[k];
+    double t1 = (half - localPos[k]) / localDir[k];
+    tEnter = std::max(tEnter, std::min(t0, t1));
+    tExit = std::min(tExit, std::max(t0, t1));
+  }
+  if (tEnter > tExit) {
+    return hitsSensor(position, position + rayLength * dir);
+  }
+
+  G4ThreeVector point = position + tEnter * dir;
+  if (hitsSensor(position, point)) {
+    return true;
+  }
+
+  // d(dir)/ds = k dir x B/|B|
+  double bMag = m_field.mag();
+  G4ThreeVector bDir = m_field / bMag;
+  double k = charge * c_light * bMag / momentum.mag();
+
+  auto insideBox = [&](const G4ThreeVector& global) {
+    G4ThreeVector local = toBox * (global - m_fieldBox.center);
+    return std::abs(local.x()) <= m_fieldBox.halfSize.x() &&
+           std::abs(local.y()) <= m_fieldBox.halfSize.y() &&
+           std::abs(local.z()) <= m_fieldBox.halfSize.z();
+  };
+
+  for (int i = 0; i < maxHelixSteps; i++) {
+    G4ThreeVector parallel = dir.dot(bDir) * bDir;
+    G4ThreeVector u = dir - parallel;
+    G4ThreeVector w = u.cross(bDir);
+
+    double phase = k * helixStep;
+    G4ThreeVector next = point + parallel * helixStep +
+                         u * (std::sin(phase) / k) +
+                         w * ((1 - std::cos(phase)) / k);
+    dir = parallel + u * std::cos(phase) + w * std::sin(phase);
+
+    if (hitsSensor(point, next)) {
+      return true;
+    }
+    point = next;
+    if (!insideBox(point)) {
+      return hitsSensor(point, point + rayLength * dir);
+    }
+  }
+  // Trapped in the field
+  return false;
+}
+
+AcceptanceFilter::Decision AcceptanceFilter::decide(
+    const G4ThreeVector& position, const G4ThreeVector& momentum,
+    double charge, double uniform) {
+  m_stats.generated++;
+  if (accepts(position, momentum, charge)) {
+    m_stats.accepted++;
+    return {1, false};
+  }
+  if (m_cfg.mode == Mode::kWeight && uniform < m_cfg.keepFraction) {
+    m_stats.rejectedSimulated++;
+    return {1 / m_cfg.keepFraction, true};
+  }
+  m_stats.skipped++;
+  return {0, true};
+}
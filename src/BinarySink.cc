@@ -0,0 +1,109 @@
+#include "BinarySink.hh"
+
+#include <algorithm>
+#include <cstring>
+
+#include "PixelStream.hh"
+
+namespace {
+
+void copy(const TVector2& v, double (&out)[2]) {
+  out[0] = v.X();
+  out[1] = v.Y();
+}
+
+void copy(const TVector3& v, double (&out)[3]) {
+  out[0] = v.X();
+  out[1] = v.Y();
+  out[2] = v.Z();
+}
+
+}  // namespace
+
+BinarySink::BinarySink(const std::string& filePath, const PixelRecord& record)
+    : m_record(record), m_file(filePath, std::ios::binary) {
+  m_buffer.reserve(bufferSize + (1 << 16));
+  PixelStream::Header header;
+  std::copy(std::begin(PixelStream::magic), std::end(PixelStream::magic),
+            header.magic);
+  header.version = PixelStream::version;
+  append(header);
+}
+
+BinarySink::~BinarySink() { flush(); }
+
+template <typename T>
+void BinarySink::append(const T& block) {
+  const char* bytes = reinterpret_cast<const char*>(&block);
+  m_buffer.insert(m_buffer.end(), bytes, bytes + sizeof(T));
+}
+
+void BinarySink::write() {
+  const PixelRecord& r = m_record;
+  std::size_t nHits = r.hitE.size();
+
+  PixelStream::Pixel pixel{
+      .kind = PixelStream::kPixel,
+      .nBytes = static_cast<std::uint32_t>(
+          sizeof(PixelStream::Pixel) + nHits * sizeof(PixelStream::Hit)),
+      .eventId = r.eventId,
+      .runId = r.runId,
+      .geoId = r.geoId,
+      .pixIdX = r.pixIdX,
+      .pixIdY = r.pixIdY,
+      .isSignal = r.isSignal,
+      .nHits = static_cast<std::uint32_t>(nHits),
+      .reserved = 0,
+      .eventWeight = r.eventWeight,
+      .totEDep = r.totEDep};
+  copy(r.geoCenterLocal, pixel.geoCenterLocal);
+  copy(r.geoCenterGlobal, pixel.geoCenterGlobal);
+  append(pixel);
+
+  for (std::size_t i = 0; i < nHits; i++) {
+    PixelStream::Hit hit{.trackId = r.trackId[i],
+                         .parentTrackId = r.parentTrackId[i],
+                         .primaryIdx = r.primaryIdx[i],
+                         .pdgId = r.pdgId[i],
+                         .eDep = r.eDep[i],
+                         .e = r.hitE[i],
+                         .p = r.hitP[i],
+                         .ipE = r.ipE[i],
+                         .ipP = r.ipP[i],
+                         .primaryE = r.hitPrimaryE[i],
+                         .primaryTheta = r.hitPrimaryTheta[i],
+                         .primaryPhi = r.hitPrimaryPhi[i],
+                         .primaryWeight = r.hitPrimaryWeight[i]};
+    copy(r.hitPosGlobal[i], hit.posGlobal);
+    copy(r.hitPosLocal[i], hit.posLocal);
+    copy(r.hitEntryPosGlobal[i], hit.entryPosGlobal);
+    copy(r.hitMomDir[i], hit.momDir);
+    copy(r.ipMomDir[i], hit.ipMomDir);
+    copy(r.vertex[i], hit.vertex);
+    append(hit);
+  }
+
+  if (m_buffer.size() >= bufferSize) {
+    flush();
+  }
+}
+
+void BinarySink::close(const Metadata& metadata) {
+  for (const auto& [name, value] : metadata) {
+    PixelStream::Metadata block{.kind = PixelStream::kMetadata,
+                                .nBytes = sizeof(PixelStream::Metadata),
+                                .name = {},
+                                .value = value};
+    std::strncpy(block.name, name.c_str(), sizeof(block.name) - 1);
+    append(block);
+  }
+  flush();
+  m_file.close();
+}
+
+void BinarySink::flush() {
+  if (!m_buffer.empty() && m_file.is_open()) {
+    m_file.write(m_buffer.data(), m_buffer.size());
+  }
+  m_buffer.clear();
+}
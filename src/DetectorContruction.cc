@@ -22,18 +22,29 @@
 #include "VacuumChamberFactory.hh"
 #include "WendellDipoleFactory.hh"
 
-DetectorConstruction::DetectorConstruction(double alongSlitTranslation,
-                                           double verticalStagger)
-    : translation(alongSlitTranslation),
-      stagger(verticalStagger),
-      G4VUserDetectorConstruction() {
+DetectorConstruction::DetectorConstruction(
+    double alongSlitTranslation, double verticalStagger,
+    TrackingChamberFactory::LevelOfDetail tcLevelOfDetail)
+    : tcDetail(tcLevelOfDetail), G4VUserDetectorConstruction() {
+  setSetupTranslation(alongSlitTranslation, verticalStagger);
+
   const GeometryConstants &gc = *GeometryConstants::instance();
-  double setupCenter = (gc.tc1CenterZ + gc.wdCenterZ + gc.tc2CenterZ) / 3.0;
-  angle = std::asin(translation / setupCenter);
+  tc1ChipAlignmentPars = gc.tc1ChipAlignmentPars;
+  tc2ChipAlignmentPars = gc.tc2ChipAlignmentPars;
 }
 
 DetectorConstruction::~DetectorConstruction() {}
 
+void DetectorConstruction::setSetupTranslation(double alongSlitTranslation,
+                                               double verticalStagger) {
+  translation = alongSlitTranslation;
+  stagger = verticalStagger;
+
+  const GeometryConstants &gc = *GeometryConstants::instance();
+  double setupCenter = (gc.tc1CenterZ + gc.wdCenterZ + gc.tc2CenterZ) / 3.0;
+  angle = std::asin(translation / setupCenter);
+}
+
 G4VPhysicalVolume *DetectorConstruction::Construct() {
   checkOverlaps = true;
   MaterialFactory::instance()->constuctMaterial();
@@ -72,11 +83,14 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
 
       .gc = GeometryConstants::instance(),
 
+      .solidModel = vcSolidModel,
+
       .checkOverlaps = true};
 
   VacuumChamberFactory vcFactory;
-  G4VPhysicalVolume *physVacuumChamber =
-      vcFactory.construct(logicWorld, vcFactoryCfg);
+  if (constructVacuumChamber) {
+    vcFactory.construct(logicWorld, vcFactoryCfg);
+  }
 
   // ---------------------------------------------------
   // Dipole construciton
@@ -127,7 +141,7 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
   TrackingChamberFactory tcFactory;
 
   std::cout << "\n\n\n\n";
-  for (const auto &[id, pars] : gc.tc1ChipAlignmentPars) {
+  for (const auto &[id, pars] : tc1ChipAlignmentPars) {
     std::cout << "ID " << id << ": " << std::get<0>(pars) << ", "
               << std::get<1>(pars) << "\n";
   }
@@ -146,7 +160,9 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
 
       .gc = GeometryConstants::instance(),
 
-      .chipAlignmentPars = gc.tc1ChipAlignmentPars,
+      .chipAlignmentPars = tc1ChipAlignmentPars,
+
+      .levelOfDetail = tcDetail,
 
       .checkOverlaps = true};
 
@@ -175,8 +191,8 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
       opppSensitiveTranslation1.x(), opppSensitiveTranslation1.y(),
       physTrackingChamber1->GetTranslation().z());
   tc1Translation -= G4ThreeVector(
-      std::get<0>(gc.tc1ChipAlignmentPars.at(gc.tc1GeoIdPrefix)),
-      std::get<1>(gc.tc1ChipAlignmentPars.at(gc.tc1GeoIdPrefix)), 0);
+      std::get<0>(tc1ChipAlignmentPars.at(gc.tc1GeoIdPrefix)),
+      std::get<1>(tc1ChipAlignmentPars.at(gc.tc1GeoIdPrefix)), 0);
   tc1Translation += G4ThreeVector(0, translation, 0);
   physTrackingChamber1->GetRotation()->rotate(angle, G4ThreeVector(1, 0, 0));
   physTrackingChamber1->SetTranslation(
@@ -186,7 +202,7 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
   // Second tracking chamber construction
 
   std::cout << "\n\n\n\n";
-  for (const auto &[id, pars] : gc.tc2ChipAlignmentPars) {
+  for (const auto &[id, pars] : tc2ChipAlignmentPars) {
     std::cout << "ID " << id << ": " << std::get<0>(pars) << ", "
               << std::get<1>(pars) << "\n";
   }
@@ -205,7 +221,9 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
 
       .gc = GeometryConstants::instance(),
 
-      .chipAlignmentPars = gc.tc2ChipAlignmentPars,
+      .chipAlignmentPars = tc2ChipAlignmentPars,
+
+      .levelOfDetail = tcDetail,
 
       .checkOverlaps = true};
 
@@ -234,8 +252,8 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
       opppSensitiveTranslation2.x(), opppSensitiveTranslation2.y(),
       physTrackingChamber2->GetTranslation().z());
   tc2Translation -= G4ThreeVector(
-      std::get<0>(gc.tc2ChipAlignmentPars.at(gc.tc2GeoIdPrefix)),
-      std::get<1>(gc.tc2ChipAlignmentPars.at(gc.tc2GeoIdPrefix)), 0);
+      std::get<0>(tc2ChipAlignmentPars.at(gc.tc2GeoIdPrefix)),
+      std::get<1>(tc2ChipAlignmentPars.at(gc.tc2GeoIdPrefix)), 0);
   tc2Translation += G4ThreeVector(0, translation + stagger, 0);
   physTrackingChamber2->GetRotation()->rotate(angle, G4ThreeVector(1, 0, 0));
   physTrackingChamber2->SetTranslation(
@@ -246,8 +264,15 @@ G4VPhysicalVolume *DetectorConstruction::Construct() {
 
 void DetectorConstruction::ConstructSDandField() {
   G4String senstitiveName = "/logicAlpideSensitive";
-  auto samplingVolume = new SamplingVolume(senstitiveName, "HitsCollection",
-                                           "ProtoTrckCarrierPCB");
-  G4SDManager::GetSDMpointer()->AddNewDetector(samplingVolume);
+
+  // The detector survives geometry reinitialization
+  G4VSensitiveDetector *samplingVolume =
+      G4SDManager::GetSDMpointer()->FindSensitiveDetector(senstitiveName,
+                                                          false);
+  if (samplingVolume == nullptr) {
+    samplingVolume = new SamplingVolume(senstitiveName, "HitsCollection",
+                                        "ProtoTrckCarrierPCB");
+    G4SDManager::GetSDMpointer()->AddNewDetector(samplingVolume);
+  }
   SetSensitiveDetector("logicAlpideSensitive", samplingVolume, true);
 }
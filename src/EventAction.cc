@@ -0,0 +1,35 @@
+#include "EventAction.hh"
+
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "MemoryMonitor.hh"
+#include "PerfCounters.hh"
+#include "ProgressReporter.hh"
+
+void EventAction::BeginOfEventAction(const G4Event* event) {
+  if (m_memory != nullptr) {
+    m_memory->beginEvent();
+  }
+  PerfCounters::push(PerfCounters::Phase::kTracking);
+}
+
+void EventAction::EndOfEventAction(const G4Event* event) {
+  PerfCounters::pop();
+  if (m_memory != nullptr) {
+    m_memory->endEvent(event->GetEventID());
+  }
+  if (m_progress == nullptr) {
+    return;
+  }
+
+  std::uint64_t nHits = 0;
+  if (auto* hcOfThisEvent = event->GetHCofThisEvent()) {
+    std::size_t nCollections = hcOfThisEvent->GetNumberOfCollections();
+    for (std::size_t i = 0; i < nCollections; i++) {
+      if (auto* hitCollection = hcOfThisEvent->GetHC(i)) {
+        nHits += hitCollection->GetSize();
+      }
+    }
+  }
+  m_progress->eventDone(nHits);
+}
@@ -0,0 +1,8 @@
+#include "EventInformation.hh"
+
+#include "G4ios.hh"
+
+void EventInformation::Print() const {
+  G4cout << "weight: " << weight
+         << " outside acceptance: " << outsideAcceptance << G4endl;
+}
@@ -0,0 +1,148 @@
+#include "EventRootSink.hh"
+
+#include <string>
+
+namespace {
+
+const char* axes = "XYZ";
+
+}  // namespace
+
+EventRootSink::EventRootSink(const std::string& filePath,
+                             const std::string& treeName,
+                             const PixelRecord& record, const Config& cfg)
+    : RootSink(filePath, treeName, cfg), m_record(record) {
+  int bufSize = cfg.basketBytes;
+  int splitLvl = 0;
+
+  // The tree reads the record on Fill and leaves it unchanged
+  auto& r = const_cast<PixelRecord&>(record);
+
+  // One branch per component, e.g. hitPosGlobalX/Y/Z
+  auto branchComponents = [&](const std::string& name,
+                              std::vector<double>* components, int n) {
+    for (int k = 0; k < n; k++) {
+      m_tree->Branch((name + axes[k]).c_str(), &components[k], bufSize,
+                     splitLvl);
+    }
+  };
+
+  m_tree->Branch("eventId", &r.eventId, bufSize, splitLvl);
+  m_tree->Branch("runId", &r.runId, bufSize, splitLvl);
+  m_tree->Branch("eventWeight", &r.eventWeight, bufSize, splitLvl);
+  m_tree->Branch("primaryE", &r.primaryE, bufSize, splitLvl);
+  m_tree->Branch("primaryTheta", &r.primaryTheta, bufSize, splitLvl);
+  m_tree->Branch("primaryPhi", &r.primaryPhi, bufSize, splitLvl);
+  m_tree->Branch("primaryWeight", &r.primaryWeight, bufSize, splitLvl);
+
+  m_tree->Branch("geoId", &m_geoId, bufSize, splitLvl);
+  m_tree->Branch("pixIdX", &m_pixIdX, bufSize, splitLvl);
+  m_tree->Branch("pixIdY", &m_pixIdY, bufSize, splitLvl);
+  m_tree->Branch("isSignal", &m_isSignal, bufSize, splitLvl);
+  branchComponents("geoCenterLocal", m_geoCenterLocal, 2);
+  branchComponents("geoCenterGlobal", m_geoCenterGlobal, 3);
+  m_tree->Branch("totEDep", &m_totEDep, bufSize, splitLvl);
+  m_tree->Branch("pixelHitOffset", &m_pixelHitOffset, bufSize, splitLvl);
+
+  m_tree->Branch("parentTrackId", &m_parentTrackId, bufSize, splitLvl);
+  m_tree->Branch("trackId", &m_trackId, bufSize, splitLvl);
+  m_tree->Branch("primaryIdx", &m_primaryIdx, bufSize, splitLvl);
+
+  branchComponents("hitPosGlobal", m_hitPosGlobal, 3);
+  branchComponents("hitPosLocal", m_hitPosLocal, 2);
+  branchComponents("hitEntryPosGlobal", m_hitEntryPosGlobal, 3);
+
+  branchComponents("hitMomDir", m_hitMomDir, 3);
+  m_tree->Branch("hitE", &m_hitE, bufSize, splitLvl);
+  m_tree->Branch("hitP", &m_hitP, bufSize, splitLvl);
+
+  branchComponents("ipMomDir", m_ipMomDir, 3);
+  m_tree->Branch("ipE", &m_ipE, bufSize, splitLvl);
+  m_tree->Branch("ipP", &m_ipP, bufSize, splitLvl);
+  branchComponents("vertex", m_vertex, 3);
+
+  m_tree->Branch("eDep", &m_eDep, bufSize, splitLvl);
+  m_tree->Branch("pdgId", &m_pdgId, bufSize, splitLvl);
+
+  m_pixelHitOffset.push_back(0);
+}
+
+EventRootSink::~EventRootSink() { close({}); }
+
+void EventRootSink::write() {
+  auto append = [](auto& to, const auto& from) {
+    to.insert(to.end(), from.begin(), from.end());
+  };
+  const PixelRecord& r = m_record;
+
+  m_geoId.push_back(r.geoId);
+  m_pixIdX.push_back(r.pixIdX);
+  m_pixIdY.push_back(r.pixIdY);
+  m_isSignal.push_back(r.isSignal);
+  m_geoCenterLocal[0].push_back(r.geoCenterLocal.X());
+  m_geoCenterLocal[1].push_back(r.geoCenterLocal.Y());
+  for (int k = 0; k < 3; k++) {
+    m_geoCenterGlobal[k].push_back(r.geoCenterGlobal[k]);
+  }
+  m_totEDep.push_back(r.totEDep);
+
+  append(m_parentTrackId, r.parentTrackId);
+  append(m_trackId, r.trackId);
+  append(m_primaryIdx, r.primaryIdx);
+  append(m_hitE, r.hitE);
+  append(m_hitP, r.hitP);
+  append(m_ipE, r.ipE);
+  append(m_ipP, r.ipP);
+  append(m_eDep, r.eDep);
+  append(m_pdgId, r.pdgId);
+  for (std::size_t i = 0; i < r.hitE.size(); i++) {
+    m_hitPosLocal[0].push_back(r.hitPosLocal[i].X());
+    m_hitPosLocal[1].push_back(r.hitPosLocal[i].Y());
+    for (int k = 0; k < 3; k++) {
+      m_hitPosGlobal[k].push_back(r.hitPosGlobal[i][k]);
+      m_hitEntryPosGlobal[k].push_back(r.hitEntryPosGlobal[i][k]);
+      m_hitMomDir[k].push_back(r.hitMomDir[i][k]);
+      m_ipMomDir[k].push_back(r.ipMomDir[i][k]);
+      m_vertex[k].push_back(r.vertex[i][k]);
+    }
+  }
+  m_pixelHitOffset.push_back(static_cast<int>(m_hitE.size()));
+}
+
+void EventRootSink::endEvent() {
+  if (m_geoId.empty()) {
+    return;
+  }
+  m_tree->Fill();
+
+  // The capacity is kept for the next events
+  for (auto* values : {&m_geoId, &m_pixIdX, &m_pixIdY, &m_isSignal,
+                       &m_pixelHitOffset, &m_parentTrackId, &m_trackId,
+                       &m_primaryIdx, &m_pdgId}) {
+    values->clear();
+  }
+  for (auto* values : {&m_totEDep, &m_hitE, &m_hitP, &m_ipE, &m_ipP,
+                       &m_eDep}) {
+    values->clear();
+  }
+  for (int k = 0; k < 3; k++) {
+    if (k < 2) {
+      m_geoCenterLocal[k].clear();
+      m_hitPosLocal[k].clear();
+    }
+    m_geoCenterGlobal[k].clear();
+    m_hitPosGlobal[k].clear();
+    m_hitEntryPosGlobal[k].clear();
+    m_hitMomDir[k].clear();
+    m_ipMomDir[k].clear();
+    m_vertex[k].clear();
+  }
+  m_pixelHitOffset.push_back(0);
+}
+
+void EventRootSink::close(const Metadata& metadata) {
+  if (m_tree != nullptr) {
+    endEvent();
+  }
+  RootSink::close(metadata);
+}
@@ -0,0 +1,60 @@
+#include "HitPrecisionReader.hh"
+
+#include <algorithm>
+#include <string>
+
+#include "RootSink.hh"
+
+HitPrecisionReader::HitPrecisionReader(TTree& tree) {
+  m_compact = tree.GetBranch("nHits") != nullptr;
+  if (!m_compact) {
+    tree.SetBranchAddress("hitPosLocal", &m_hitPosLocal);
+    tree.SetBranchAddress("hitMomDir", &m_hitMomDir);
+    tree.SetBranchAddress("vertex", &m_vertex);
+    return;
+  }
+
+  // The arrays are read in place, so hold the largest entry
+  auto maxHits = static_cast<std::size_t>(
+      std::max(1.0, tree.GetMaximum("nHits")));
+  auto setArray = [&](const std::string& name, auto& values) {
+    values.resize(maxHits);
+    tree.SetBranchAddress(name.c_str(), values.data());
+  };
+  const char* axes = "XYZ";
+  for (int k = 0; k < 3; k++) {
+    if (k < 2) {
+      setArray(std::string("hitOffsetLocal") + axes[k], m_hitOffsetLocal[k]);
+    }
+    setArray(std::string("hitMomDir") + axes[k], m_hitMomDirComponents[k]);
+    // Double32_t is a double in memory
+    setArray(std::string("vertex") + axes[k], m_vertexComponents[k]);
+  }
+}
+
+TVector2 HitPrecisionReader::hitPosLocal(
+    std::size_t i, const TVector2& geoCenterLocal) const {
+  if (!m_compact) {
+    return m_hitPosLocal->at(i);
+  }
+  return TVector2(
+      geoCenterLocal.X() + RootSink::offsetQuantum * m_hitOffsetLocal[0][i],
+      geoCenterLocal.Y() + RootSink::offsetQuantum * m_hitOffsetLocal[1][i]);
+}
+
+TVector3 HitPrecisionReader::hitMomDir(std::size_t i) const {
+  if (!m_compact) {
+    return m_hitMomDir->at(i);
+  }
+  return TVector3(m_hitMomDirComponents[0][i] / RootSink::directionScale,
+                  m_hitMomDirComponents[1][i] / RootSink::directionScale,
+                  m_hitMomDirComponents[2][i] / RootSink::directionScale);
+}
+
+TVector3 HitPrecisionReader::vertex(std::size_t i) const {
+  if (!m_compact) {
+    return m_vertex->at(i);
+  }
+  return TVector3(m_vertexComponents[0][i], m_vertexComponents[1][i],
+                  m_vertexComponents[2][i]);
+}
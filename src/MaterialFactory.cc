@@ -111,6 +111,12 @@ void MaterialFactory::constructPBT() {
 }
 
 void MaterialFactory::constuctMaterial() {
+  // Materials are not deleted when the geometry is rebuilt
+  if (m_constructed) {
+    return;
+  }
+  m_constructed = true;
+
   constructAl6061();
 
   constructMildSteel();
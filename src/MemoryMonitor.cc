@@ -0,0 +1,131 @@
+#include "MemoryMonitor.hh"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "G4ios.hh"
+#include "Run.hh"
+#include "SamplingHit.hh"
+
+namespace {
+
+double megabytes(std::uint64_t bytes) { return bytes / (1024.0 * 1024.0); }
+
+}  // namespace
+
+MemoryMonitor::MemoryMonitor(const Config& cfg)
+    : m_cfg(cfg),
+      m_statmFd(open("/proc/self/statm", O_RDONLY)),
+      m_pageSize(sysconf(_SC_PAGESIZE)) {}
+
+MemoryMonitor::~MemoryMonitor() {
+  if (m_statmFd >= 0) {
+    close(m_statmFd);
+  }
+}
+
+std::uint64_t MemoryMonitor::residentBytes() const {
+  // Kept open, one pread per sample
+  char text[128];
+  ssize_t n = m_statmFd >= 0 ? pread(m_statmFd, text, sizeof(text) - 1, 0)
+                             : -1;
+  if (n <= 0) {
+    return 0;
+  }
+  text[n] = '\0';
+  char* end;
+  std::strtoull(text, &end, 10);
+  return std::strtoull(end, nullptr, 10) * m_pageSize;
+}
+
+void MemoryMonitor::recordStartup(const std::string& stage) {
+  m_startup.emplace_back(stage, residentBytes());
+}
+
+void MemoryMonitor::beginRun(Run* run) {
+  // The kernel builds the physics tables just before the first run
+  if (!m_tablesRecorded) {
+    recordStartup("physics tables");
+    m_tablesRecorded = true;
+  }
+  m_run = run;
+  m_events = 0;
+  m_peakRss = residentBytes();
+  m_maxEventGrowth = 0;
+  m_maxGrowthEventId = -1;
+  m_flushes = 0;
+  TrackerHitPoolStats.highWater = TrackerHitPoolStats.live;
+}
+
+void MemoryMonitor::endRun() {
+  if (m_events > 0) {
+    report("end of run");
+  }
+  m_run = nullptr;
+}
+
+void MemoryMonitor::beginEvent() { m_eventStartRss = residentBytes(); }
+
+void MemoryMonitor::endEvent(int eventId) {
+  std::uint64_t rss = residentBytes();
+  if (rss > m_peakRss) {
+    m_peakRss = rss;
+  }
+  if (rss > m_eventStartRss && rss - m_eventStartRss > m_maxEventGrowth) {
+    m_maxEventGrowth = rss - m_eventStartRss;
+    m_maxGrowthEventId = eventId;
+  }
+
+  if (m_cfg.budget > 0 && rss > m_cfg.budget && m_run != nullptr &&
+      m_run->bufferedBytes() >= m_cfg.minFlushBytes) {
+    m_run->flushOutput();
+    m_flushes++;
+    // Freed memory need not return to the system at once
+    if (residentBytes() > m_cfg.budget && !m_budgetWarned) {
+      G4cerr << "RSS " << megabytes(residentBytes())
+             << " MB stays above the budget of " << megabytes(m_cfg.budget)
+             << " MB after flushing the output buffers" << G4endl;
+      m_budgetWarned = true;
+    }
+  }
+
+  m_events++;
+  if (m_cfg.reportEvery > 0 && m_events % m_cfg.reportEvery == 0) {
+    report("progress");
+  }
+}
+
+void MemoryMonitor::report(const char* title) const {
+  char line[160];
+  G4cout << "\nMemory, " << title << " after " << m_events << " events"
+         << G4endl;
+  std::uint64_t previous = 0;
+  for (const auto& [stage, rss] : m_startup) {
+    std::snprintf(line, sizeof(line), "  %-28s RSS %9.1f MB  %+9.1f MB",
+                  stage.c_str(), megabytes(rss),
+                  previous > 0 ? megabytes(rss) - megabytes(previous) : 0.0);
+    G4cout << line << G4endl;
+    previous = rss;
+  }
+  std::snprintf(line, sizeof(line),
+                "  %-28s RSS %9.1f MB, peak %.1f MB, largest event growth "
+                "%.2f MB (event %d)",
+                "events", megabytes(residentBytes()), megabytes(m_peakRss),
+                megabytes(m_maxEventGrowth), m_maxGrowthEventId);
+  G4cout << line << G4endl;
+  std::snprintf(line, sizeof(line),
+                "  %-28s %zu live, high water %zu, pool %.1f MB", "SamplingHit",
+                TrackerHitPoolStats.live, TrackerHitPoolStats.highWater,
+                TrackerHitAllocator != nullptr
+                    ? megabytes(TrackerHitAllocator->GetAllocatedSize())
+                    : 0.0);
+  G4cout << line << G4endl;
+  std::snprintf(line, sizeof(line), "  %-28s %.2f MB, %llu budget flushes",
+                "output buffers",
+                m_run != nullptr ? megabytes(m_run->bufferedBytes()) : 0.0,
+                static_cast<unsigned long long>(m_flushes));
+  G4cout << line << G4endl;
+}
@@ -0,0 +1,265 @@
+#include "MomentumTable.hh"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "G4ios.hh"
+
+namespace {
+
+constexpr char magic[4] = {'A', 'L', 'M', 'T'};
+constexpr std::uint32_t version = 1;
+
+using Point = std::array<float, 3>;
+
+struct Bin {
+  double lower[3];
+  double upper[3];
+  std::size_t count;
+};
+
+/// Splits points [begin, end) at the median of the coordinate with
+/// the largest range in units of its global spread
+void split(std::vector<Point>& points, std::size_t begin, std::size_t end,
+           const double scale[3], std::size_t maxEntries,
+           std::vector<Bin>& bins) {
+  Bin bin{{1e300, 1e300, 1e300}, {-1e300, -1e300, -1e300}, end - begin};
+  for (std::size_t i = begin; i < end; i++) {
+    for (int k = 0; k < 3; k++) {
+      bin.lower[k] = std::min<double>(bin.lower[k], points[i][k]);
+      bin.upper[k] = std::max<double>(bin.upper[k], points[i][k]);
+    }
+  }
+
+  int dim = 0;
+  double widest = 0;
+  for (int k = 0; k < 3; k++) {
+    double width = (bin.upper[k] - bin.lower[k]) / scale[k];
+    if (width > widest) {
+      widest = width;
+      dim = k;
+    }
+  }
+  if (end - begin <= maxEntries || widest == 0) {
+    bins.push_back(bin);
+    return;
+  }
+
+  std::size_t middle = begin + (end - begin) / 2;
+  std::nth_element(
+      points.begin() + begin, points.begin() + middle, points.begin() + end,
+      [dim](const Point& a, const Point& b) { return a[dim] < b[dim]; });
+  split(points, begin, middle, scale, maxEntries, bins);
+  split(points, middle, end, scale, maxEntries, bins);
+}
+
+}  // namespace
+
+MomentumTable::MomentumTable(const Config& cfg) : m_cfg(cfg) {
+  Key key = makeKey();
+  if (!m_cfg.cachePath.empty() && load(key)) {
+    m_fromCache = true;
+    G4cout << "Momentum table " << m_cfg.cachePath << ": " << nBins()
+           << " bins of " << m_nSamples << " momenta" << G4endl;
+    return;
+  }
+
+  build();
+  G4cout << "Momentum table built from " << m_cfg.sourcePath << ": "
+         << nBins() << " bins of " << m_nSamples << " momenta" << G4endl;
+  if (valid() && !m_cfg.cachePath.empty()) {
+    store(key);
+  }
+}
+
+MomentumTable::Key MomentumTable::makeKey() const {
+  // A missing source leaves the zero size and time, which
+  // matches only a cache built under the same condition
+  std::error_code ec;
+  std::uint64_t size = std::filesystem::file_size(m_cfg.sourcePath, ec);
+  auto time = std::filesystem::last_write_time(m_cfg.sourcePath, ec);
+  return {.sourceSize = ec ? 0 : size,
+          .sourceTime = ec ? 0 : time.time_since_epoch().count(),
+          .maxEntriesPerBin = m_cfg.maxEntriesPerBin,
+          .maxSamples = m_cfg.maxSamples,
+          .seed = m_cfg.seed};
+}
+
+bool MomentumTable::load(const Key& key) {
+  std::ifstream file(m_cfg.cachePath, std::ios::binary);
+  char fileMagic[4];
+  std::uint32_t fileVersion;
+  Key fileKey;
+  std::uint64_t nSamples, nBins;
+  file.read(fileMagic, sizeof(fileMagic));
+  file.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion));
+  file.read(reinterpret_cast<char*>(&fileKey), sizeof(fileKey));
+  file.read(reinterpret_cast<char*>(&nSamples), sizeof(nSamples));
+  file.read(reinterpret_cast<char*>(&nBins), sizeof(nBins));
+  if (!file || !std::equal(fileMagic, fileMagic + 4, magic) ||
+      fileVersion != version || !(fileKey == key)) {
+    return false;
+  }
+
+  m_lower.resize(3 * nBins);
+  m_upper.resize(3 * nBins);
+  m_prob.resize(nBins);
+  m_alias.resize(nBins);
+  file.read(reinterpret_cast<char*>(m_lower.data()),
+            m_lower.size() * sizeof(double));
+  file.read(reinterpret_cast<char*>(m_upper.data()),
+            m_upper.size() * sizeof(double));
+  file.read(reinterpret_cast<char*>(m_prob.data()),
+            m_prob.size() * sizeof(double));
+  file.read(reinterpret_cast<char*>(m_alias.data()),
+            m_alias.size() * sizeof(std::uint32_t));
+  if (!file) {
+    m_prob.clear();
+    return false;
+  }
+  m_nSamples = nSamples;
+  return true;
+}
+
+void MomentumTable::store(const Key& key) const {
+  std::filesystem::path path(m_cfg.cachePath);
+  std::string tmpPath = m_cfg.cachePath + ".tmp";
+  {
+    std::ofstream file(tmpPath, std::ios::binary);
+    std::uint64_t nSamples = m_nSamples, nBins = m_prob.size();
+    file.write(magic, sizeof(magic));
+    file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+    file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    file.write(reinterpret_cast<const char*>(&nSamples), sizeof(nSamples));
+    file.write(reinterpret_cast<const char*>(&nBins), sizeof(nBins));
+    file.write(reinterpret_cast<const char*>(m_lower.data()),
+               m_lower.size() * sizeof(double));
+    file.write(reinterpret_cast<const char*>(m_upper.data()),
+               m_upper.size() * sizeof(double));
+    file.write(reinterpret_cast<const char*>(m_prob.data()),
+               m_prob.size() * sizeof(double));
+    file.write(reinterpret_cast<const char*>(m_alias.data()),
+               m_alias.size() * sizeof(std::uint32_t));
+    if (!file) {
+      G4cerr << "Cannot write the momentum table " << tmpPath << G4endl;
+      return;
+    }
+  }
+  // Concurrent jobs never read a partial table
+  std::error_code ec;
+  std::filesystem::rename(tmpPath, path, ec);
+}
+
+void MomentumTable::build() {
+  // Reservoir sample of at most maxSamples momenta
+  std::vector<Point> points;
+  std::mt19937_64 rng(m_cfg.seed);
+  std::ifstream file(m_cfg.sourcePath);
+  std::string line;
+  std::uint64_t nRead = 0;
+  while (std::getline(file, line)) {
+    const char* text = line.c_str();
+    char* end;
+    Point point;
+    bool ok = true;
+    for (int k = 0; k < 3 && ok; k++) {
+      point[k] = std::strtod(text, &end);
+      ok = end != text;
+      text = *end == ',' ? end + 1 : end;
+    }
+    if (!ok) {
+      continue;
+    }
+
+    if (points.size() < m_cfg.maxSamples) {
+      points.push_back(point);
+    } else {
+      std::uint64_t j =
+          std::uniform_int_distribution<std::uint64_t>(0, nRead)(rng);
+      if (j < points.size()) {
+        points[j] = point;
+      }
+    }
+    nRead++;
+  }
+  m_nSamples = points.size();
+  if (points.empty()) {
+    return;
+  }
+
+  double scale[3];
+  for (int k = 0; k < 3; k++) {
+    double sum = 0, sum2 = 0;
+    for (const Point& point : points) {
+      sum += point[k];
+      sum2 += static_cast<double>(point[k]) * point[k];
+    }
+    double mean = sum / points.size();
+    scale[k] = std::sqrt(std::max(sum2 / points.size() - mean * mean, 0.0));
+    if (scale[k] == 0) {
+      scale[k] = 1;
+    }
+  }
+
+  std::vector<Bin> bins;
+  split(points, 0, points.size(), scale,
+        std::max<std::size_t>(m_cfg.maxEntriesPerBin, 1), bins);
+
+  std::size_t n = bins.size();
+  m_lower.resize(3 * n);
+  m_upper.resize(3 * n);
+  for (std::size_t i = 0; i < n; i++) {
+    for (int k = 0; k < 3; k++) {
+      m_lower[3 * i + k] = bins[i].lower[k];
+      m_upper[3 * i + k] = bins[i].upper[k];
+    }
+  }
+
+  // Vose's alias method on the bin counts
+  m_prob.resize(n);
+  m_alias.resize(n);
+  std::vector<double> scaled(n);
+  std::vector<std::uint32_t> small, large;
+  for (std::size_t i = 0; i < n; i++) {
+    scaled[i] = static_cast<double>(bins[i].count) * n / points.size();
+    (scaled[i] < 1 ? small : large).push_back(i);
+  }
+  while (!small.empty() && !large.empty()) {
+    std::uint32_t s = small.back();
+    std::uint32_t l = large.back();
+    small.pop_back();
+    m_prob[s] = scaled[s];
+    m_alias[s] = l;
+    scaled[l] -= 1 - scaled[s];
+    if (scaled[l] < 1) {
+      large.pop_back();
+      small.push_back(l);
+    }
+  }
+  // Left over by the rounding
+  for (std::uint32_t i : large) {
+    m_prob[i] = 1;
+    m_alias[i] = i;
+  }
+  for (std::uint32_t i : small) {
+    m_prob[i] = 1;
+    m_alias[i] = i;
+  }
+}
+
+void MomentumTable::sample(std::mt19937& rng, double momentum[3]) const {
+  std::uniform_real_distribution<> uniform(0, 1);
+  double u = uniform(rng) * m_prob.size();
+  auto column = std::min<std::size_t>(u, m_prob.size() - 1);
+  std::size_t bin = u - column < m_prob[column] ? column : m_alias[column];
+  for (int k = 0; k < 3; k++) {
+    double lower = m_lower[3 * bin + k];
+    momentum[k] = lower + (m_upper[3 * bin + k] - lower) * uniform(rng);
+  }
+}
@@ -0,0 +1,114 @@
+#include "OutputSink.hh"
+
+#include "BinarySink.hh"
+#include "Compression.h"
+#include "EventRootSink.hh"
+#include "RNTupleSink.hh"
+#include "RootSink.hh"
+
+namespace {
+
+/// Discards the records, which leaves the simulation alone to be timed
+class NullSink : public OutputSink {
+ public:
+  void write() override {}
+  void close(const Metadata&) override {}
+};
+
+}  // namespace
+
+std::unique_ptr<OutputSink> OutputSink::create(const Config& cfg,
+                                               const std::string& filePath,
+                                               const std::string& treeName,
+                                               const PixelRecord& record) {
+  if (filePath.empty()) {
+    return std::make_unique<NullSink>();
+  }
+  switch (cfg.format) {
+    case Format::kRoot:
+      return std::make_unique<RootSink>(filePath, treeName, record, cfg);
+    case Format::kRootEvents:
+      return std::make_unique<EventRootSink>(filePath, treeName, record,
+                                             cfg);
+    case Format::kBinary:
+      return std::make_unique<BinarySink>(filePath, record);
+    case Format::kRNTuple:
+#ifdef WITH_RNTUPLE
+      return std::make_unique<RNTupleSink>(filePath, treeName, record, cfg);
+#else
+      break;
+#endif
+    case Format::kNull:
+      break;
+  }
+  return std::make_unique<NullSink>();
+}
+
+std::optional<OutputSink::Format> OutputSink::formatFromName(
+    const std::string& name) {
+  if (name == "root") {
+    return Format::kRoot;
+  } else if (name == "root-events") {
+    return Format::kRootEvents;
+  } else if (name == "binary") {
+    return Format::kBinary;
+#ifdef WITH_RNTUPLE
+  } else if (name == "rntuple") {
+    return Format::kRNTuple;
+#endif
+  } else if (name == "null") {
+    return Format::kNull;
+  }
+  return std::nullopt;
+}
+
+std::optional<int> OutputSink::compressionFromName(const std::string& name) {
+  using Algorithm = ROOT::RCompressionSetting::EAlgorithm::EValues;
+  std::string algorithmName = name.substr(0, name.find(':'));
+  if (algorithmName == "none") {
+    return 0;
+  }
+
+  // Default levels of the ROOT presets
+  Algorithm algorithm;
+  int level;
+  if (algorithmName == "zlib") {
+    algorithm = Algorithm::kZLIB;
+    level = 1;
+  } else if (algorithmName == "lzma") {
+    algorithm = Algorithm::kLZMA;
+    level = 7;
+  } else if (algorithmName == "lz4") {
+    algorithm = Algorithm::kLZ4;
+    level = 4;
+  } else if (algorithmName == "zstd") {
+    algorithm = Algorithm::kZSTD;
+    level = 5;
+  } else {
+    return std::nullopt;
+  }
+  if (name.size() > algorithmName.size()) {
+    std::string levelName = name.substr(algorithmName.size() + 1);
+    if (levelName.size() != 1 || levelName[0] < '1' || levelName[0] > '9') {
+      return std::nullopt;
+    }
+    level = levelName[0] - '0';
+  }
+  return ROOT::CompressionSettings(algorithm, level);
+}
+
+std::string OutputSink::extension(Format format) {
+  switch (format) {
+    case Format::kRoot:
+      return ".root";
+    case Format::kRootEvents:
+      return ".events.root";
+    case Format::kBinary:
+      return ".bin";
+    case Format::kRNTuple:
+      return ".rntuple.root";
+    case Format::kNull:
+      break;
+  }
+  return "";
+}
@@ -0,0 +1,235 @@
+#include "PerfCounters.hh"
+
+#include <linux/perf_event.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <ctime>
+#include <memory>
+#include <mutex>
+
+#include "G4ios.hh"
+
+namespace {
+
+constexpr const char* phaseNames[PerfCounters::kNumPhases] = {
+    "other", "generation", "tracking", "sensitive detector",
+    "RecordEvent", "output"};
+
+constexpr std::uint64_t counterConfigs[PerfCounters::kNumCounters] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+
+// All threads that entered a phase, in the order they did
+std::mutex registryMutex;
+std::vector<std::unique_ptr<PerfCounters>> registry;
+
+thread_local PerfCounters* threadCounters = nullptr;
+
+int openCounter(std::uint64_t config, int groupFd) {
+  perf_event_attr attr{};
+  attr.size = sizeof(attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.config = config;
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  return static_cast<int>(
+      syscall(SYS_perf_event_open, &attr, 0, -1, groupFd, 0));
+}
+
+double threadCpuSeconds() {
+  timespec time;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+  return time.tv_sec + 1e-9 * time.tv_nsec;
+}
+
+}  // namespace
+
+PerfCounters::PerfCounters() {
+  m_fds[kCycles] = openCounter(counterConfigs[kCycles], -1);
+  m_hardware = m_fds[kCycles] >= 0;
+  long pageSize = sysconf(_SC_PAGESIZE);
+  for (int k = 0; k < kNumCounters && m_hardware; k++) {
+    if (k > 0) {
+      m_fds[k] = openCounter(counterConfigs[k], m_fds[kCycles]);
+    }
+    if (m_fds[k] < 0) {
+      continue;
+    }
+    void* page = mmap(nullptr, pageSize, PROT_READ, MAP_SHARED, m_fds[k], 0);
+    m_pages[k] = page == MAP_FAILED ? nullptr : page;
+  }
+  m_stack.reserve(16);
+  read(m_last);
+}
+
+PerfCounters::~PerfCounters() {
+  long pageSize = sysconf(_SC_PAGESIZE);
+  for (int k = 0; k < kNumCounters; k++) {
+    if (m_pages[k] != nullptr) {
+      munmap(m_pages[k], pageSize);
+    }
+    if (m_fds[k] >= 0) {
+      close(m_fds[k]);
+    }
+  }
+}
+
+PerfCounters& PerfCounters::forThread() {
+  if (threadCounters == nullptr) {
+    std::lock_guard<std::mutex> lock(registryMutex);
+    registry.emplace_back(new PerfCounters());
+    threadCounters = registry.back().get();
+    threadCounters->m_threadIdx = static_cast<int>(registry.size()) - 1;
+    if (!threadCounters->m_hardware && registry.size() == 1) {
+      G4cerr << "No hardware performance counters, only the CPU time of "
+                "the phases is counted"
+             << G4endl;
+    }
+  }
+  return *threadCounters;
+}
+
+void PerfCounters::enter(Phase phase) {
+  checkpoint();
+  m_stack.push_back(phase);
+  m_totals[static_cast<int>(phase)].entries++;
+}
+
+void PerfCounters::leave() {
+  checkpoint();
+  if (!m_stack.empty()) {
+    m_stack.pop_back();
+  }
+}
+
+void PerfCounters::checkpoint() {
+  Snapshot now;
+  read(now);
+  Phase phase = m_stack.empty() ? Phase::kOther : m_stack.back();
+  Totals& totals = m_totals[static_cast<int>(phase)];
+  for (int k = 0; k < kNumCounters; k++) {
+    totals.counts[k] += now.counts[k] - m_last.counts[k];
+  }
+  totals.cpuSeconds += now.cpuSeconds - m_last.cpuSeconds;
+  m_last = now;
+}
+
+bool PerfCounters::readUser(int counter, std::uint64_t& value) const {
+#if defined(__x86_64__)
+  // Self-monitoring sequence of perf_event_open(2)
+  const auto* page =
+      static_cast<const volatile perf_event_mmap_page*>(m_pages[counter]);
+  if (page == nullptr) {
+    return false;
+  }
+  std::uint32_t sequence;
+  std::uint64_t count;
+  do {
+    sequence = page->lock;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    std::uint32_t index = page->index;
+    if (!page->cap_user_rdpmc || index == 0) {
+      return false;
+    }
+    std::int64_t pmc = __builtin_ia32_rdpmc(index - 1);
+    int shift = 64 - page->pmc_width;
+    pmc = static_cast<std::int64_t>(static_cast<std::uint64_t>(pmc) << shift) >>
+          shift;
+    count = page->offset + pmc;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  } while (page->lock != sequence);
+  value = count;
+  return true;
+#else
+  return false;
+#endif
+}
+
+void PerfCounters::read(Snapshot& snapshot) const {
+  bool user = m_hardware;
+  for (int k = 0; k < kNumCounters; k++) {
+    snapshot.counts[k] = 0;
+    if (user && m_fds[k] >= 0) {
+      user = readUser(k, snapshot.counts[k]);
+    }
+  }
+  if (m_hardware && !user) {
+    // The values come in the order the counters joined the group
+    std::uint64_t group[1 + kNumCounters];
+    if (::read(m_fds[kCycles], group, sizeof(group)) > 0) {
+      int position = 0;
+      for (int k = 0; k < kNumCounters; k++) {
+        snapshot.counts[k] = m_fds[k] >= 0 ? group[1 + position++] : 0;
+      }
+    }
+  }
+  snapshot.cpuSeconds = threadCpuSeconds();
+}
+
+void PerfCounters::resetAll() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (auto& counters : registry) {
+    for (Totals& totals : counters->m_totals) {
+      totals = Totals();
+    }
+  }
+}
+
+void PerfCounters::report() {
+  std::lock_guard<std::mutex> lock(registryMutex);
+  for (const auto& counters : registry) {
+    double cpuSeconds = 0;
+    for (const Totals& totals : counters->m_totals) {
+      cpuSeconds += totals.cpuSeconds;
+    }
+
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "\nThread %d per phase\n%-20s %10s %10s %7s",
+                  counters->m_threadIdx, "phase", "entries", "cpu [s]",
+                  "cpu %");
+    G4cout << line;
+    if (counters->m_hardware) {
+      std::snprintf(line, sizeof(line), " %10s %6s %12s %12s\n%51s %12s %12s",
+                    "Gcycles", "IPC", "cache miss", "branch miss", "",
+                    "/kinstr", "/kinstr");
+      G4cout << line;
+    }
+    G4cout << G4endl;
+    for (int p = 0; p < kNumPhases; p++) {
+      const Totals& totals = counters->m_totals[p];
+      if (totals.entries == 0 && p != static_cast<int>(Phase::kOther)) {
+        continue;
+      }
+      double share = cpuSeconds > 0 ? 100 * totals.cpuSeconds / cpuSeconds : 0;
+      if (!counters->m_hardware) {
+        std::snprintf(line, sizeof(line), "%-20s %10llu %10.3f %7.2f",
+                      phaseNames[p],
+                      static_cast<unsigned long long>(totals.entries),
+                      totals.cpuSeconds, share);
+        G4cout << line << G4endl;
+        continue;
+      }
+      double kiloInstructions = 1e-3 * totals.counts[kInstructions];
+      auto perKilo = [&](int counter) {
+        return kiloInstructions > 0 ? totals.counts[counter] / kiloInstructions
+                                    : 0.0;
+      };
+      std::snprintf(
+          line, sizeof(line),
+          "%-20s %10llu %10.3f %7.2f %10.3f %6.2f %12.3f %12.3f",
+          phaseNames[p], static_cast<unsigned long long>(totals.entries),
+          totals.cpuSeconds, share, 1e-9 * totals.counts[kCycles],
+          totals.counts[kCycles] > 0
+              ? static_cast<double>(totals.counts[kInstructions]) /
+                    totals.counts[kCycles]
+              : 0.0,
+          perKilo(kCacheMisses), perKilo(kBranchMisses));
+      G4cout << line << G4endl;
+    }
+  }
+}
@@ -0,0 +1,98 @@
+#include "PhaseSpacePrimaryGeneratorAction.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "EventInformation.hh"
+#include "G4Exception.hh"
+#include "G4IonTable.hh"
+#include "G4ParticleTable.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "PerfCounters.hh"
+
+PhaseSpacePrimaryGeneratorAction::PhaseSpacePrimaryGeneratorAction(
+    const std::string& path)
+    : m_file(path, std::ios::binary), G4VUserPrimaryGeneratorAction() {
+  m_particleGun = new G4ParticleGun(1);
+
+  m_file.read(reinterpret_cast<char*>(&m_header), sizeof(m_header));
+  if (!m_file ||
+      std::memcmp(m_header.magic, PhaseSpace::magic, sizeof(m_header.magic)) !=
+          0 ||
+      m_header.version != PhaseSpace::version) {
+    G4Exception("PhaseSpacePrimaryGeneratorAction::",
+                "PhaseSpacePrimaryGeneratorAction()", FatalException,
+                ("Not a phase-space file: " + path).c_str());
+  }
+  rewind();
+}
+
+void PhaseSpacePrimaryGeneratorAction::rewind() {
+  m_file.clear();
+  m_file.seekg(sizeof(PhaseSpace::Header));
+  m_hasNext = static_cast<bool>(
+      m_file.read(reinterpret_cast<char*>(&m_next), sizeof(m_next)));
+}
+
+bool PhaseSpacePrimaryGeneratorAction::readEvent() {
+  m_event.clear();
+  if (!m_hasNext) {
+    return false;
+  }
+
+  std::uint32_t eventId = m_next.eventId;
+  while (m_hasNext && m_next.eventId == eventId) {
+    m_event.push_back(m_next);
+    m_hasNext = static_cast<bool>(
+        m_file.read(reinterpret_cast<char*>(&m_next), sizeof(m_next)));
+  }
+
+  // The beam particle gets the track id 1 again, when it reached
+  // the plane. Its stage one ids go with it, see GeneratePrimaries
+  std::stable_partition(m_event.begin(), m_event.end(),
+                        [](const PhaseSpace::Record& record) {
+                          return record.parentTrackId == 0;
+                        });
+  return true;
+}
+
+void PhaseSpacePrimaryGeneratorAction::GeneratePrimaries(G4Event* event) {
+  PerfCounters::Scope scope(PerfCounters::Phase::kGeneration);
+
+  if (!readEvent()) {
+    return;
+  }
+
+  // Replayed particle k gets the track id k + 1 and the parent 0
+  // whatever it was in stage one, so Run tells the beam particle by
+  // the stage one ids
+  auto information = new EventInformation();
+  G4ParticleTable* particleTable = G4ParticleTable::GetParticleTable();
+  for (const auto& record : m_event) {
+    G4ParticleDefinition* particle = particleTable->FindParticle(record.pdgId);
+    if (particle == nullptr) {
+      particle = G4IonTable::GetIonTable()->GetIon(record.pdgId);
+    }
+    if (particle == nullptr) {
+      continue;
+    }
+
+    double dirX = record.dirX;
+    double dirY = record.dirY;
+    double dirZ = std::sqrt(std::max(0.0, 1.0 - dirX * dirX - dirY * dirY));
+
+    m_particleGun->SetParticleDefinition(particle);
+    m_particleGun->SetParticlePosition(
+        G4ThreeVector(record.x * mm, record.y * mm, m_header.planeZ * mm));
+    m_particleGun->SetParticleMomentumDirection(
+        G4ThreeVector(dirX, dirY, dirZ));
+    m_particleGun->SetParticleEnergy(record.eKin * MeV);
+    m_particleGun->SetParticleTime(record.time * ns);
+    m_particleGun->GeneratePrimaryVertex(event);
+    information->originTrackId.push_back(record.trackId);
+    information->originParentTrackId.push_back(record.parentTrackId);
+  }
+  event->SetUserInformation(information);
+}
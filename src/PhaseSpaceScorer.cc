@@ -0,0 +1,86 @@
+#include "PhaseSpaceScorer.hh"
+
+#include <algorithm>
+
+#include "G4Event.hh"
+#include "G4EventManager.hh"
+#include "G4Step.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4Track.hh"
+
+PhaseSpaceScorer::PhaseSpaceScorer(const std::string& filePath,
+                                   double planeZ)
+    : m_file(filePath, std::ios::binary), G4UserSteppingAction() {
+  std::copy(std::begin(PhaseSpace::magic), std::end(PhaseSpace::magic),
+            m_header.magic);
+  m_header.version = PhaseSpace::version;
+  m_header.planeZ = planeZ / mm;
+  m_header.nEvents = 0;
+  m_header.nStoredEvents = 0;
+  m_header.nRecords = 0;
+
+  // Rewritten with the counts on close
+  m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+  m_buffer.reserve(1 << 16);
+}
+
+PhaseSpaceScorer::~PhaseSpaceScorer() {
+  flush();
+  m_file.seekp(0);
+  m_file.write(reinterpret_cast<const char*>(&m_header), sizeof(m_header));
+}
+
+void PhaseSpaceScorer::flush() {
+  m_file.write(reinterpret_cast<const char*>(m_buffer.data()),
+               m_buffer.size() * sizeof(PhaseSpace::Record));
+  m_buffer.clear();
+}
+
+void PhaseSpaceScorer::UserSteppingAction(const G4Step* step) {
+  // The event manager is the one of the worker thread
+  int eventId =
+      G4EventManager::GetEventManager()->GetConstCurrentEvent()->GetEventID();
+  if (eventId != m_lastEventId) {
+    m_lastEventId = eventId;
+    m_header.nEvents++;
+  }
+
+  const G4StepPoint* pre = step->GetPreStepPoint();
+  const G4StepPoint* post = step->GetPostStepPoint();
+  double planeZ = m_header.planeZ * mm;
+  if (pre->GetPosition().z() >= planeZ || post->GetPosition().z() < planeZ) {
+    return;
+  }
+
+  // Vacuum behind the flange, the step is straight
+  double f = (planeZ - pre->GetPosition().z()) /
+             (post->GetPosition().z() - pre->GetPosition().z());
+  G4ThreeVector position =
+      pre->GetPosition() + f * (post->GetPosition() - pre->GetPosition());
+  double time =
+      pre->GetGlobalTime() + f * (post->GetGlobalTime() - pre->GetGlobalTime());
+
+  G4Track* track = step->GetTrack();
+  const G4ThreeVector& dir = post->GetMomentumDirection();
+  m_buffer.push_back(
+      {.eventId = static_cast<std::uint32_t>(eventId),
+       .pdgId = track->GetParticleDefinition()->GetPDGEncoding(),
+       .trackId = track->GetTrackID(),
+       .parentTrackId = track->GetParentID(),
+       .x = static_cast<float>(position.x() / mm),
+       .y = static_cast<float>(position.y() / mm),
+       .dirX = static_cast<float>(dir.x()),
+       .dirY = static_cast<float>(dir.y()),
+       .eKin = static_cast<float>(post->GetKineticEnergy() / MeV),
+       .time = static_cast<float>(time / ns)});
+  m_header.nRecords++;
+  if (eventId != m_lastStoredEventId) {
+    m_lastStoredEventId = eventId;
+    m_header.nStoredEvents++;
+  }
+  if (m_buffer.size() == m_buffer.capacity()) {
+    flush();
+  }
+
+  track->SetTrackStatus(fStopAndKill);
+}
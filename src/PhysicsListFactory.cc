@@ -0,0 +1,91 @@
+#include "PhysicsListFactory.hh"
+
+#include "FTFP_BERT.hh"
+#include "G4DecayPhysics.hh"
+#include "G4EmExtraPhysics.hh"
+#include "G4EmStandardPhysics.hh"
+#include "G4EmStandardPhysics_option3.hh"
+#include "G4EmStandardPhysics_option4.hh"
+#include "G4StepLimiterPhysics.hh"
+
+namespace {
+
+// Electromagnetic physics with the decays. G4DecayPhysics also
+// defines the full particle set, which the gamma-nuclear
+// secondaries need
+class EmPhysicsList : public G4VModularPhysicsList {
+ public:
+  EmPhysicsList(PhysicsListFactory::Model model, G4bool gammaNuclear,
+                G4int verbose) {
+    SetVerboseLevel(verbose);
+
+    switch (model) {
+      case PhysicsListFactory::Model::kEmStandardOpt3:
+        RegisterPhysics(new G4EmStandardPhysics_option3(verbose));
+        break;
+      case PhysicsListFactory::Model::kEmStandardOpt4:
+        RegisterPhysics(new G4EmStandardPhysics_option4(verbose));
+        break;
+      default:
+        RegisterPhysics(new G4EmStandardPhysics(verbose));
+        break;
+    }
+    RegisterPhysics(new G4DecayPhysics(verbose));
+
+    if (gammaNuclear) {
+      auto emExtra = new G4EmExtraPhysics(verbose);
+      emExtra->GammaNuclear(true);
+      emExtra->ElectroNuclear(true);
+      emExtra->MuonNuclear(false);
+      RegisterPhysics(emExtra);
+    }
+  }
+};
+
+}  // namespace
+
+G4VModularPhysicsList* PhysicsListFactory::construct(const Config& cfg) {
+  G4VModularPhysicsList* physicsList;
+  if (cfg.model == Model::kFtfpBert) {
+    physicsList = new FTFP_BERT(cfg.verbose);
+  } else {
+    physicsList = new EmPhysicsList(cfg.model, cfg.gammaNuclear, cfg.verbose);
+  }
+
+  if (cfg.stepLimiter) {
+    physicsList->RegisterPhysics(new G4StepLimiterPhysics());
+  }
+  return physicsList;
+}
+
+std::optional<PhysicsListFactory::Model> PhysicsListFactory::modelFromName(
+    const std::string& name) {
+  if (name == "FTFP_BERT") {
+    return Model::kFtfpBert;
+  } else if (name == "EM0") {
+    return Model::kEmStandard;
+  } else if (name == "EM3") {
+    return Model::kEmStandardOpt3;
+  } else if (name == "EM4") {
+    return Model::kEmStandardOpt4;
+  }
+  return std::nullopt;
+}
+
+std::string PhysicsListFactory::name(const Config& cfg) {
+  std::string name;
+  switch (cfg.model) {
+    case Model::kFtfpBert:
+      return "FTFP_BERT";
+    case Model::kEmStandard:
+      name = "EM0";
+      break;
+    case Model::kEmStandardOpt3:
+      name = "EM3";
+      break;
+    case Model::kEmStandardOpt4:
+      name = "EM4";
+      break;
+  }
+  return cfg.gammaNuclear ? name + "+GN" : name;
+}
@@ -0,0 +1,125 @@
+#include "PhysicsTableCache.hh"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include "G4Element.hh"
+#include "G4Material.hh"
+#include "G4ProductionCuts.hh"
+#include "G4Region.hh"
+#include "G4RegionStore.hh"
+#include "G4Version.hh"
+#include "G4ios.hh"
+
+namespace {
+
+// Written after the tables, marks a complete entry
+const char* keyFileName = "key.txt";
+
+std::uint64_t fnv1a(const std::string& text) {
+  std::uint64_t hash = 14695981039346656037ull;
+  for (unsigned char c : text) {
+    hash ^= c;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+}  // namespace
+
+PhysicsTableCache::PhysicsTableCache(const Config& cfg) : m_cfg(cfg) {}
+
+std::string PhysicsTableCache::describe(
+    const G4VUserPhysicsList* physicsList) const {
+  std::ostringstream out;
+  out.precision(17);
+
+  out << "geant4 " << G4Version << "\n";
+  out << "physics " << m_cfg.physicsListName << "\n";
+  out << "defaultCut " << physicsList->GetDefaultCutValue() << "\n";
+
+  // Cuts of gamma, e-, e+ and proton
+  for (const G4Region* region : *G4RegionStore::GetInstance()) {
+    out << "region " << region->GetName();
+    const G4ProductionCuts* cuts = region->GetProductionCuts();
+    for (G4int i = 0; i < 4; i++) {
+      out << " " << (cuts != nullptr ? cuts->GetProductionCut(i) : -1.0);
+    }
+    out << "\n";
+  }
+
+  for (const G4Material* material : *G4Material::GetMaterialTable()) {
+    out << "material " << material->GetName() << " "
+        << material->GetDensity() << " " << material->GetState() << " "
+        << material->GetTemperature() << " " << material->GetPressure();
+    const G4double* fractions = material->GetFractionVector();
+    for (std::size_t i = 0; i < material->GetNumberOfElements(); i++) {
+      const G4Element* element = material->GetElement(i);
+      out << " " << element->GetZ() << ":" << element->GetN() << ":"
+          << fractions[i];
+    }
+    out << "\n";
+  }
+  return out.str();
+}
+
+void PhysicsTableCache::update(const G4VUserPhysicsList* physicsList) {
+  m_key = describe(physicsList);
+
+  char hash[17];
+  std::snprintf(hash, sizeof(hash), "%016llx",
+                static_cast<unsigned long long>(fnv1a(m_key)));
+  m_directory = (std::filesystem::path(m_cfg.cacheDir) / hash).string();
+}
+
+G4bool PhysicsTableCache::retrieve(G4VUserPhysicsList* physicsList) {
+  update(physicsList);
+
+  std::ifstream keyFile(std::filesystem::path(m_directory) / keyFileName);
+  std::string storedKey(std::istreambuf_iterator<char>(keyFile), {});
+  m_retrieving = keyFile.is_open() && storedKey == m_key;
+
+  if (m_retrieving) {
+    G4cout << "PhysicsTableCache: retrieving the tables from " << m_directory
+           << G4endl;
+    physicsList->SetPhysicsTableRetrieved(m_directory);
+  } else {
+    G4cout << "PhysicsTableCache: no tables in " << m_directory << G4endl;
+  }
+  return m_retrieving;
+}
+
+G4bool PhysicsTableCache::store(G4VUserPhysicsList* physicsList) {
+  // A failed retrieval switches the physics list to building
+  if (m_retrieving && physicsList->IsPhysicsTableRetrieved()) {
+    return true;
+  }
+  if (m_key.empty()) {
+    update(physicsList);
+  }
+
+  std::error_code error;
+  std::filesystem::remove(std::filesystem::path(m_directory) / keyFileName,
+                          error);
+  std::filesystem::create_directories(m_directory, error);
+  if (error) {
+    G4cerr << "PhysicsTableCache: cannot create " << m_directory << ": "
+           << error.message() << G4endl;
+    return false;
+  }
+  if (!physicsList->StorePhysicsTable(m_directory)) {
+    G4cerr << "PhysicsTableCache: failed to store the tables in "
+           << m_directory << G4endl;
+    return false;
+  }
+
+  std::ofstream keyFile(std::filesystem::path(m_directory) / keyFileName);
+  keyFile << m_key;
+  G4cout << "PhysicsTableCache: stored the tables in " << m_directory
+         << G4endl;
+  return keyFile.good();
+}
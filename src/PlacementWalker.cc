@@ -0,0 +1,32 @@
+#include "PlacementWalker.hh"
+
+#include "G4LogicalVolume.hh"
+
+namespace {
+
+void walk(const G4VPhysicalVolume* volume, const G4RotationMatrix& rotation,
+          const G4ThreeVector& translation, const PlacementVisitor& visitor) {
+  if (!visitor(volume, rotation, translation)) {
+    return;
+  }
+
+  const G4LogicalVolume* logic = volume->GetLogicalVolume();
+  for (std::size_t i = 0; i < logic->GetNoDaughters(); i++) {
+    const G4VPhysicalVolume* daughter = logic->GetDaughter(i);
+
+    // Placements hold the inverse, frame rotation
+    G4RotationMatrix daughterRotation = rotation;
+    if (daughter->GetRotation() != nullptr) {
+      daughterRotation = rotation * daughter->GetRotation()->inverse();
+    }
+    walk(daughter, daughterRotation,
+         rotation * daughter->GetTranslation() + translation, visitor);
+  }
+}
+
+}  // namespace
+
+void walkPlacements(const G4VPhysicalVolume* world,
+                    const PlacementVisitor& visitor) {
+  walk(world, G4RotationMatrix(), G4ThreeVector(), visitor);
+}
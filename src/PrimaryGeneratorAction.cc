@@ -1,10 +1,12 @@
 #include "PrimaryGeneratorAction.hh"
 
+#include <chrono>
 #include <cmath>
-#include <random>
 
+#include "EventInformation.hh"
 #include "G4ParticleTable.hh"
 #include "G4ThreeVector.hh"
+#include "PerfCounters.hh"
 
 PrimaryGeneratorAction::PrimaryGeneratorAction(int nParticles,
                                                double particleEnergyMin,
@@ -12,38 +14,54 @@ PrimaryGeneratorAction::PrimaryGeneratorAction(int nParticles,
                                                double sigmaTheta,
                                                double sigmaPhi)
     : m_nParticles(nParticles),
-      m_particleEnergyMin(particleEnergyMin),
-      m_particleEnergyMax(particleEnergyMax),
-      m_sigmaTheta(sigmaTheta),
-      m_sigmaPhi(sigmaPhi),
+      m_sampler({.energyMin = particleEnergyMin,
+                 .energyMax = particleEnergyMax,
+                 .sigmaTheta = sigmaTheta,
+                 .sigmaPhi = sigmaPhi,
+                 .engine = PrimarySampler::Engine::kMersenneTwister,
+                 .seed = static_cast<std::uint64_t>(
+                     std::chrono::system_clock::now()
+                         .time_since_epoch()
+                         .count())}),
       G4VUserPrimaryGeneratorAction() {
-  m_particleGun = new G4ParticleGun(m_nParticles);
+  // One particle per vertex, GeneratePrimaries shoots m_nParticles
+  m_particleGun = new G4ParticleGun(1);
 
   m_particle = G4ParticleTable::GetParticleTable()->FindParticle(11);
 
   m_particleGun->SetParticleDefinition(m_particle);
+}
 
-  m_rng.seed(std::chrono::system_clock::now().time_since_epoch().count());
+void PrimaryGeneratorAction::setParticle(const G4String& particleName) {
+  m_particle = G4ParticleTable::GetParticleTable()->FindParticle(particleName);
+  m_particleGun->SetParticleDefinition(m_particle);
 }
 
 void PrimaryGeneratorAction::GeneratePrimaries(G4Event* event) {
-  auto normal = std::normal_distribution<>(0, 1);
-  auto uniform = std::uniform_real_distribution<>(0, 1);
+  PerfCounters::Scope scope(PerfCounters::Phase::kGeneration);
 
   m_particleGun->SetParticlePosition(G4ThreeVector());
 
-  for (std::size_t i = 0; i < m_particleGun->GetNumberOfParticles(); i++) {
-    double E = m_particleEnergyMin +
-               (m_particleEnergyMax - m_particleEnergyMin) * uniform(m_rng);
-
-    double phi = m_sigmaPhi * normal(m_rng);
-    double theta = m_sigmaTheta * normal(m_rng);
+  m_sampler.sample(event->GetEventID(), m_nParticles, m_block);
+  for (std::size_t i = 0; i < m_block.size(); i++) {
+    double phi = m_block.phi[i];
+    double theta = m_block.theta[i];
 
     G4ThreeVector dir(std::sin(theta) * std::cos(phi),
                       std::sin(theta) * std::sin(phi), std::cos(theta));
 
-    m_particleGun->SetParticleEnergy(E);
+    m_particleGun->SetParticleEnergy(m_block.energy[i]);
     m_particleGun->SetParticleMomentumDirection(dir);
     m_particleGun->GeneratePrimaryVertex(event);
   }
+
+  auto information = new EventInformation();
+  for (double weight : m_block.weight) {
+    information->weight *= weight;
+  }
+  information->primaryE = m_block.energy;
+  information->primaryTheta = m_block.theta;
+  information->primaryPhi = m_block.phi;
+  information->primaryWeight = m_block.weight;
+  event->SetUserInformation(information);
 }
@@ -0,0 +1,26 @@
+#include "PrimaryIndexTrackingAction.hh"
+
+#include "G4Track.hh"
+#include "G4TrackingManager.hh"
+#include "TrackInformation.hh"
+
+void PrimaryIndexTrackingAction::PreUserTrackingAction(const G4Track* track) {
+  if (track->GetParentID() == 0 && track->GetUserInformation() == nullptr) {
+    track->SetUserInformation(new TrackInformation(track->GetTrackID() - 1));
+  }
+}
+
+void PrimaryIndexTrackingAction::PostUserTrackingAction(const G4Track* track) {
+  const auto* information =
+      static_cast<const TrackInformation*>(track->GetUserInformation());
+  G4TrackVector* secondaries = fpTrackingManager->GimmeSecondaries();
+  if (information == nullptr || secondaries == nullptr) {
+    return;
+  }
+  for (G4Track* secondary : *secondaries) {
+    if (secondary->GetUserInformation() == nullptr) {
+      secondary->SetUserInformation(
+          new TrackInformation(information->primaryIdx));
+    }
+  }
+}
@@ -0,0 +1,126 @@
+#include "PrimarySampler.hh"
+
+#include <algorithm>
+#include <cmath>
+
+#include "G4PhysicalConstants.hh"
+#include "Philox.hh"
+
+namespace {
+
+double gaussianDensity(double x, double sigma) {
+  if (sigma <= 0) {
+    return 1;
+  }
+  return std::exp(-0.5 * x * x / (sigma * sigma)) /
+         (std::sqrt(twopi) * sigma);
+}
+
+}  // namespace
+
+PrimarySampler::PrimarySampler(const Config& cfg) : m_cfg(cfg) {
+  setSeed(cfg.seed);
+}
+
+void PrimarySampler::setSeed(std::uint64_t seed) {
+  m_cfg.seed = seed;
+  m_rng.seed(seed);
+}
+
+void PrimarySampler::sample(std::uint64_t eventId, std::size_t n,
+                            Block& block) {
+  block.energy.resize(n);
+  block.theta.resize(n);
+  block.phi.resize(n);
+  block.weight.resize(n);
+  if (m_cfg.engine == Engine::kPhilox) {
+    samplePhilox(eventId, n, block);
+  } else {
+    sampleMersenneTwister(n, block);
+  }
+  computeWeights(block);
+}
+
+double PrimarySampler::nominalDensity(double energy, double theta,
+                                      double phi) const {
+  return nominalEnergyDensity(energy) * nominalAngleDensity(theta, phi);
+}
+
+double PrimarySampler::nominalEnergyDensity(double energy) const {
+  double range = m_cfg.energyMax - m_cfg.energyMin;
+  return range > 0 ? 1 / range : 1;
+}
+
+double PrimarySampler::nominalAngleDensity(double theta, double phi) const {
+  return gaussianDensity(theta, m_cfg.sigmaTheta) *
+         gaussianDensity(phi, m_cfg.sigmaPhi);
+}
+
+double PrimarySampler::proposalDensity(double energy, double theta,
+                                       double phi) const {
+  double range = m_cfg.energyMax - m_cfg.energyMin;
+  double energyDensity = range > 0 ? 1 / range : 1;
+  if (range > 0 && m_cfg.energyProposal == EnergyProposal::kLogFlat) {
+    energyDensity =
+        1 / (energy * std::log(m_cfg.energyMax / m_cfg.energyMin));
+  }
+  double scale = m_cfg.angleProposalScale;
+  return energyDensity * gaussianDensity(theta, scale * m_cfg.sigmaTheta) *
+         gaussianDensity(phi, scale * m_cfg.sigmaPhi);
+}
+
+double PrimarySampler::proposalEnergy(double u) const {
+  if (m_cfg.energyProposal == EnergyProposal::kLogFlat &&
+      m_cfg.energyMax > m_cfg.energyMin) {
+    return m_cfg.energyMin * std::pow(m_cfg.energyMax / m_cfg.energyMin, u);
+  }
+  return m_cfg.energyMin + (m_cfg.energyMax - m_cfg.energyMin) * u;
+}
+
+void PrimarySampler::computeWeights(Block& block) const {
+  if (m_cfg.energyProposal == EnergyProposal::kFlat &&
+      m_cfg.angleProposalScale == 1) {
+    std::fill(block.weight.begin(), block.weight.end(), 1.0);
+    return;
+  }
+  for (std::size_t i = 0; i < block.size(); i++) {
+    block.weight[i] =
+        nominalDensity(block.energy[i], block.theta[i], block.phi[i]) /
+        proposalDensity(block.energy[i], block.theta[i], block.phi[i]);
+  }
+}
+
+void PrimarySampler::sampleMersenneTwister(std::size_t n, Block& block) {
+  auto normal = std::normal_distribution<>(0, 1);
+  auto uniform = std::uniform_real_distribution<>(0, 1);
+
+  double scale = m_cfg.angleProposalScale;
+  for (std::size_t i = 0; i < n; i++) {
+    block.energy[i] = proposalEnergy(uniform(m_rng));
+    block.phi[i] = scale * m_cfg.sigmaPhi * normal(m_rng);
+    block.theta[i] = scale * m_cfg.sigmaTheta * normal(m_rng);
+  }
+}
+
+void PrimarySampler::samplePhilox(std::uint64_t eventId, std::size_t n,
+                                  Block& block) {
+  // Energy, Box-Muller radius and Box-Muller angle uniforms
+  m_uniforms.resize(3 * n);
+  Philox::fillUniforms(Philox::makeKey(m_cfg.seed), eventId,
+                       m_uniforms.data(), m_uniforms.size());
+  const double* energyU = m_uniforms.data();
+  const double* radiusU = energyU + n;
+  const double* angleU = radiusU + n;
+
+  for (std::size_t i = 0; i < n; i++) {
+    block.energy[i] = proposalEnergy(energyU[i]);
+  }
+  double sigmaPhi = m_cfg.angleProposalScale * m_cfg.sigmaPhi;
+  double sigmaTheta = m_cfg.angleProposalScale * m_cfg.sigmaTheta;
+  for (std::size_t i = 0; i < n; i++) {
+    double radius = std::sqrt(-2 * std::log(radiusU[i]));
+    double angle = twopi * angleU[i];
+    block.phi[i] = sigmaPhi * radius * std::cos(angle);
+    block.theta[i] = sigmaTheta * radius * std::sin(angle);
+  }
+}
@@ -0,0 +1,173 @@
+#include "Profiler.hh"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "G4LogicalVolume.hh"
+#include "G4ParticleDefinition.hh"
+#include "G4Step.hh"
+#include "G4Track.hh"
+#include "G4VPhysicalVolume.hh"
+#include "G4VProcess.hh"
+#include "G4ios.hh"
+
+namespace {
+
+/// Prints the rows by decreasing time, the ones past nRows summed
+template <typename Key, typename Name>
+void printRanking(const char* title,
+                  const std::unordered_map<Key, Profiler::Counters>& counters,
+                  std::size_t nRows, Name name) {
+  std::vector<std::pair<std::string, Profiler::Counters>> rows;
+  Profiler::Counters total;
+  for (const auto& [key, entry] : counters) {
+    rows.emplace_back(name(key), entry);
+    total.steps += entry.steps;
+    total.tracks += entry.tracks;
+    total.seconds += entry.seconds;
+  }
+  std::sort(rows.begin(), rows.end(), [](const auto& a, const auto& b) {
+    return a.second.seconds > b.second.seconds;
+  });
+  if (rows.size() > nRows) {
+    Profiler::Counters other;
+    for (std::size_t i = nRows; i < rows.size(); i++) {
+      other.steps += rows[i].second.steps;
+      other.tracks += rows[i].second.tracks;
+      other.seconds += rows[i].second.seconds;
+    }
+    std::string otherName =
+        "(" + std::to_string(rows.size() - nRows) + " more)";
+    rows.resize(nRows);
+    rows.emplace_back(otherName, other);
+  }
+
+  char line[160];
+  std::snprintf(line, sizeof(line), "%-28s %12s %10s %10s %7s %9s", title,
+                "steps", "tracks", "time [s]", "time %", "ns/step");
+  G4cout << line << G4endl;
+  for (const auto& [rowName, entry] : rows) {
+    std::snprintf(
+        line, sizeof(line), "%-28.28s %12llu %10llu %10.3f %7.2f %9.1f",
+        rowName.c_str(), static_cast<unsigned long long>(entry.steps),
+        static_cast<unsigned long long>(entry.tracks), entry.seconds,
+        total.seconds > 0 ? 100 * entry.seconds / total.seconds : 0.0,
+        entry.steps > 0 ? 1e9 * entry.seconds / entry.steps : 0.0);
+    G4cout << line << G4endl;
+  }
+  G4cout << G4endl;
+}
+
+}  // namespace
+
+Profiler::Profiler(const Config& cfg) : m_cfg(cfg) {}
+
+void Profiler::beginTrack(const G4Track* track) {
+  m_particle = &m_particles[track->GetDefinition()];
+  m_process = &m_processes[track->GetCreatorProcess()];
+  m_particle->tracks++;
+  m_process->tracks++;
+
+  // Excludes the stacking and the other actions between the tracks
+  m_last = Clock::now();
+}
+
+void Profiler::step(const G4Step* step) {
+  Clock::time_point now = Clock::now();
+  double seconds = std::chrono::duration<double>(now - m_last).count();
+  m_last = now;
+
+  // Most steps stay in the volume of the previous one
+  const G4LogicalVolume* volume =
+      step->GetPreStepPoint()->GetPhysicalVolume()->GetLogicalVolume();
+  if (volume != m_lastVolume) {
+    m_lastVolume = volume;
+    m_volume = &m_volumes[volume];
+  }
+  if (step->IsFirstStepInVolume()) {
+    m_volume->tracks++;
+  }
+  m_volume->steps++;
+  m_volume->seconds += seconds;
+  m_particle->steps++;
+  m_particle->seconds += seconds;
+  m_process->steps++;
+  m_process->seconds += seconds;
+}
+
+void Profiler::reset() {
+  m_volumes.clear();
+  m_particles.clear();
+  m_processes.clear();
+  m_particle = nullptr;
+  m_process = nullptr;
+  m_lastVolume = nullptr;
+  m_volume = nullptr;
+}
+
+void Profiler::report() const {
+  G4cout << "\nProfile of the run, wall time between the steps\n" << G4endl;
+  printRanking("logical volume", m_volumes, m_cfg.nRows,
+               [](const G4LogicalVolume* volume) -> std::string {
+                 return volume->GetName();
+               });
+  printRanking("particle", m_particles, m_cfg.nRows,
+               [](const G4ParticleDefinition* particle) -> std::string {
+                 return particle->GetParticleName();
+               });
+  printRanking("creator process", m_processes, m_cfg.nRows,
+               [](const G4VProcess* process) -> std::string {
+                 return process != nullptr ? process->GetProcessName()
+                                           : "primary";
+               });
+}
+
+// --- Actions
+
+ProfilingSteppingAction::ProfilingSteppingAction(Profiler& profiler,
+                                                 G4UserSteppingAction* inner)
+    : m_profiler(profiler), m_inner(inner), G4UserSteppingAction() {}
+
+void ProfilingSteppingAction::SetSteppingManagerPointer(
+    G4SteppingManager* manager) {
+  G4UserSteppingAction::SetSteppingManagerPointer(manager);
+  if (m_inner) {
+    m_inner->SetSteppingManagerPointer(manager);
+  }
+}
+
+void ProfilingSteppingAction::UserSteppingAction(const G4Step* step) {
+  // The wrapped action is part of the cost of the step
+  if (m_inner) {
+    m_inner->UserSteppingAction(step);
+  }
+  m_profiler.step(step);
+}
+
+ProfilingTrackingAction::ProfilingTrackingAction(Profiler& profiler,
+                                                 G4UserTrackingAction* inner)
+    : m_profiler(profiler), m_inner(inner), G4UserTrackingAction() {}
+
+void ProfilingTrackingAction::SetTrackingManagerPointer(
+    G4TrackingManager* manager) {
+  G4UserTrackingAction::SetTrackingManagerPointer(manager);
+  if (m_inner) {
+    m_inner->SetTrackingManagerPointer(manager);
+  }
+}
+
+void ProfilingTrackingAction::PreUserTrackingAction(const G4Track* track) {
+  if (m_inner) {
+    m_inner->PreUserTrackingAction(track);
+  }
+  m_profiler.beginTrack(track);
+}
+
+void ProfilingTrackingAction::PostUserTrackingAction(const G4Track* track) {
+  if (m_inner) {
+    m_inner->PostUserTrackingAction(track);
+  }
+}
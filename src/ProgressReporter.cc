@@ -0,0 +1,175 @@
+#include "ProgressReporter.hh"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <system_error>
+
+#include "G4Threading.hh"
+
+namespace {
+
+double now() {
+  return std::chrono::duration<double>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+/// Resident set size from /proc, 0 where unavailable
+std::uint64_t residentBytes() {
+  std::ifstream statm("/proc/self/statm");
+  std::uint64_t size = 0, resident = 0;
+  statm >> size >> resident;
+  return resident * sysconf(_SC_PAGESIZE);
+}
+
+/// 1d 02h 03m 04s
+std::string formatDuration(double seconds) {
+  auto s = static_cast<long long>(seconds);
+  char text[64];
+  if (s >= 86400) {
+    std::snprintf(text, sizeof(text), "%lldd %02lldh %02lldm", s / 86400,
+                  s / 3600 % 24, s / 60 % 60);
+  } else {
+    std::snprintf(text, sizeof(text), "%02lldh %02lldm %02llds", s / 3600,
+                  s / 60 % 60, s % 60);
+  }
+  return text;
+}
+
+}  // namespace
+
+ProgressReporter::ProgressReporter(const Config& cfg) : m_cfg(cfg) {}
+
+ProgressReporter::~ProgressReporter() { stop(); }
+
+std::size_t ProgressReporter::slotIndex() {
+  int id = G4Threading::G4GetThreadId() + 1;
+  return id < 0 ? 0 : static_cast<std::size_t>(id) % kMaxSlots;
+}
+
+void ProgressReporter::start(int runId, std::uint64_t nEvents,
+                             const std::string& outputPath) {
+  stop();
+  m_runId = runId;
+  m_nEvents = nEvents;
+  m_outputPath = outputPath;
+  for (Slot& slot : m_slots) {
+    slot.events.store(0, std::memory_order_relaxed);
+    slot.hits.store(0, std::memory_order_relaxed);
+  }
+  m_lastEvents.fill(0);
+  m_lastHits = 0;
+  m_startTime = m_lastTime = now();
+
+  m_stopping = false;
+  m_thread = std::thread(&ProgressReporter::loop, this);
+}
+
+void ProgressReporter::stop() {
+  if (!m_thread.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_thread.join();
+  report(true);
+}
+
+void ProgressReporter::loop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  auto interval = std::chrono::duration<double>(m_cfg.interval);
+  while (!m_wake.wait_for(lock, interval, [this] { return m_stopping; })) {
+    report(false);
+  }
+}
+
+void ProgressReporter::report(bool finished) {
+  double time = now();
+  double elapsed = time - m_startTime;
+  double window = finished ? elapsed : time - m_lastTime;
+
+  std::uint64_t events = 0, hits = 0;
+  std::array<double, kMaxSlots> slotRates{};
+  for (std::size_t i = 0; i < kMaxSlots; i++) {
+    std::uint64_t slotEvents =
+        m_slots[i].events.load(std::memory_order_relaxed);
+    hits += m_slots[i].hits.load(std::memory_order_relaxed);
+    events += slotEvents;
+    std::uint64_t since = finished ? slotEvents : slotEvents - m_lastEvents[i];
+    slotRates[i] = window > 0 ? since / window : 0;
+    m_lastEvents[i] = slotEvents;
+  }
+  double rate = 0;
+  for (double slotRate : slotRates) {
+    rate += slotRate;
+  }
+  std::uint64_t newHits = finished ? hits : hits - m_lastHits;
+  double hitRate = window > 0 ? newHits / window : 0;
+  m_lastHits = hits;
+  m_lastTime = time;
+
+  std::error_code ec;
+  std::uint64_t outputBytes = std::filesystem::file_size(m_outputPath, ec);
+  if (ec) {
+    outputBytes = 0;
+  }
+  std::uint64_t rss = residentBytes();
+  std::uint64_t remaining = events < m_nEvents ? m_nEvents - events : 0;
+  double eta = rate > 0 ? remaining / rate : -1;
+
+  // Rates of the threads that processed events, for stderr and JSON
+  std::string threads, threadList;
+  for (std::size_t i = 0; i < kMaxSlots; i++) {
+    if (m_lastEvents[i] > 0) {
+      char entry[32];
+      std::snprintf(entry, sizeof(entry), "%.1f", slotRates[i]);
+      threads += (threads.empty() ? "" : " ") + std::string(entry);
+      threadList += (threadList.empty() ? "" : ",") + std::string(entry);
+    }
+  }
+  std::fprintf(stderr,
+               "Run %d %s: %llu/%llu events (%.2f %%), %.1f events/s "
+               "[%s], %.4g hits/s, output %.1f MB, RSS %.1f MB, %s %s\n",
+               m_runId, finished ? "done" : "progress",
+               static_cast<unsigned long long>(events),
+               static_cast<unsigned long long>(m_nEvents),
+               m_nEvents > 0 ? 100.0 * events / m_nEvents : 100.0, rate,
+               threads.c_str(), hitRate, outputBytes / 1e6, rss / 1e6,
+               finished ? "elapsed" : "ETA",
+               finished   ? formatDuration(elapsed).c_str()
+               : eta >= 0 ? formatDuration(eta).c_str()
+                          : "unknown");
+
+  if (m_cfg.statusPath.empty()) {
+    return;
+  }
+  // Readers never see a partial status
+  std::string tmpPath = m_cfg.statusPath + ".tmp";
+  std::FILE* file = std::fopen(tmpPath.c_str(), "w");
+  if (file == nullptr) {
+    return;
+  }
+  std::fprintf(file,
+               "{\"runId\": %d, \"finished\": %s, \"events\": %llu, "
+               "\"eventsToProcess\": %llu, \"elapsedSeconds\": %.1f, "
+               "\"eventsPerSecond\": %.6g, \"threadEventsPerSecond\": [%s], "
+               "\"hitsPerSecond\": %.6g, \"outputBytes\": %llu, "
+               "\"rssBytes\": %llu, \"etaSeconds\": %.1f}\n",
+               m_runId, finished ? "true" : "false",
+               static_cast<unsigned long long>(events),
+               static_cast<unsigned long long>(m_nEvents), elapsed, rate,
+               threadList.c_str(), hitRate,
+               static_cast<unsigned long long>(outputBytes),
+               static_cast<unsigned long long>(rss), finished ? 0 : eta);
+  std::fclose(file);
+  std::error_code renameError;
+  std::filesystem::rename(tmpPath, m_cfg.statusPath, renameError);
+}
@@ -0,0 +1,182 @@
+#include "RNTupleSink.hh"
+
+#ifdef WITH_RNTUPLE
+
+#include "ROOT/RNTupleFillContext.hxx"
+#include "ROOT/RNTupleFillStatus.hxx"
+#include "ROOT/RNTupleModel.hxx"
+#include "ROOT/RNTupleParallelWriter.hxx"
+#include "ROOT/RNTupleWriteOptions.hxx"
+#include "TFile.h"
+#include "TParameter.h"
+#include "TROOT.h"
+
+namespace {
+
+using FillContextPtr = decltype(std::declval<ROOT::RNTupleParallelWriter&>()
+                                    .CreateFillContext());
+using EntryPtr = decltype(std::declval<FillContextPtr&>()
+                              ->GetModel()
+                              .CreateBareEntry());
+
+void copy(const std::vector<TVector2>& in,
+          std::vector<std::array<double, 2>>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); i++) {
+    out[i] = {in[i].X(), in[i].Y()};
+  }
+}
+
+void copy(const std::vector<TVector3>& in,
+          std::vector<std::array<double, 3>>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); i++) {
+    out[i] = {in[i].X(), in[i].Y(), in[i].Z()};
+  }
+}
+
+}  // namespace
+
+struct RNTupleSink::Writer {
+  std::unique_ptr<ROOT::RNTupleParallelWriter> writer;
+  int openSinks = 0;
+};
+
+struct RNTupleSink::FillState {
+  FillContextPtr context;
+  EntryPtr entry;
+};
+
+std::mutex RNTupleSink::s_writersMutex;
+std::map<std::string, std::shared_ptr<RNTupleSink::Writer>>
+    RNTupleSink::s_writers;
+
+template <typename F>
+void RNTupleSink::forEachField(F&& f) {
+  // The fields only read the record
+  auto& r = const_cast<PixelRecord&>(m_record);
+
+  f("geoId", &r.geoId);
+  f("pixIdX", &r.pixIdX);
+  f("pixIdY", &r.pixIdY);
+  f("isSignal", &r.isSignal);
+  f("geoCenterLocal", &m_geoCenterLocal);
+  f("geoCenterGlobal", &m_geoCenterGlobal);
+  f("totEDep", &r.totEDep);
+  f("parentTrackId", &r.parentTrackId);
+  f("trackId", &r.trackId);
+  f("primaryIdx", &r.primaryIdx);
+  f("eventId", &r.eventId);
+  f("runId", &r.runId);
+  f("eventWeight", &r.eventWeight);
+  f("hitPosGlobal", &m_hitPosGlobal);
+  f("hitPosLocal", &m_hitPosLocal);
+  f("hitEntryPosGlobal", &m_hitEntryPosGlobal);
+  f("hitMomDir", &m_hitMomDir);
+  f("hitE", &r.hitE);
+  f("hitP", &r.hitP);
+  f("ipMomDir", &m_ipMomDir);
+  f("ipE", &r.ipE);
+  f("ipP", &r.ipP);
+  f("vertex", &m_vertex);
+  f("eDep", &r.eDep);
+  f("pdgId", &r.pdgId);
+  f("hitPrimaryE", &r.hitPrimaryE);
+  f("hitPrimaryTheta", &r.hitPrimaryTheta);
+  f("hitPrimaryPhi", &r.hitPrimaryPhi);
+  f("hitPrimaryWeight", &r.hitPrimaryWeight);
+}
+
+RNTupleSink::RNTupleSink(const std::string& filePath,
+                         const std::string& ntupleName,
+                         const PixelRecord& record, const Config& cfg)
+    : m_filePath(filePath), m_record(record) {
+  {
+    std::lock_guard<std::mutex> lock(s_writersMutex);
+    std::shared_ptr<Writer>& writer = s_writers[filePath];
+    if (!writer) {
+      // Fill contexts of several threads share the file
+      ROOT::EnableThreadSafety();
+      auto model = ROOT::RNTupleModel::CreateBare();
+      forEachField([&](const char* name, auto* value) {
+        model->MakeField<std::remove_pointer_t<decltype(value)>>(name);
+      });
+      ROOT::RNTupleWriteOptions options;
+      options.SetApproxZippedClusterSize(cfg.clusterBytes);
+      options.SetMaxUnzippedPageSize(cfg.pageBytes);
+      if (cfg.compression >= 0) {
+        options.SetCompression(cfg.compression);
+      }
+      writer = std::make_shared<Writer>();
+      writer->writer = ROOT::RNTupleParallelWriter::Recreate(
+          std::move(model), ntupleName, filePath, options);
+    }
+    writer->openSinks++;
+    m_writer = writer;
+  }
+
+  // Every sink fills its own clusters, without locking
+  m_fill = std::make_unique<FillState>();
+  m_fill->context = m_writer->writer->CreateFillContext();
+  m_fill->entry = m_fill->context->GetModel().CreateBareEntry();
+  forEachField([&](const char* name, auto* value) {
+    m_fill->entry->BindRawPtr(name, value);
+  });
+}
+
+RNTupleSink::~RNTupleSink() { close({}); }
+
+void RNTupleSink::write() {
+  const PixelRecord& r = m_record;
+  m_geoCenterLocal = {r.geoCenterLocal.X(), r.geoCenterLocal.Y()};
+  m_geoCenterGlobal = {r.geoCenterGlobal.X(), r.geoCenterGlobal.Y(),
+                       r.geoCenterGlobal.Z()};
+  copy(r.hitPosGlobal, m_hitPosGlobal);
+  copy(r.hitPosLocal, m_hitPosLocal);
+  copy(r.hitEntryPosGlobal, m_hitEntryPosGlobal);
+  copy(r.hitMomDir, m_hitMomDir);
+  copy(r.ipMomDir, m_ipMomDir);
+  copy(r.vertex, m_vertex);
+  // Fill without the flush reports the size of the open cluster
+  ROOT::RNTupleFillStatus status;
+  m_fill->context->FillNoFlush(*m_fill->entry, status);
+  if (status.ShouldFlushCluster()) {
+    flush();
+  } else {
+    m_clusterBytes = status.GetUnzippedClusterSize();
+  }
+}
+
+void RNTupleSink::flush() {
+  if (m_fill) {
+    m_fill->context->FlushCluster();
+  }
+  m_clusterBytes = 0;
+}
+
+void RNTupleSink::close(const Metadata& metadata) {
+  if (!m_writer) {
+    return;
+  }
+  // The context hands its last cluster to the writer when destroyed
+  m_fill.reset();
+
+  std::lock_guard<std::mutex> lock(s_writersMutex);
+  bool last = --m_writer->openSinks == 0;
+  if (last) {
+    // Commits the RNTuple and closes the file
+    m_writer->writer.reset();
+    s_writers.erase(m_filePath);
+  }
+  m_writer.reset();
+  if (!last) {
+    return;
+  }
+  TFile file(m_filePath.c_str(), "UPDATE");
+  for (const auto& [name, value] : metadata) {
+    TParameter<double>(name.c_str(), value).Write();
+  }
+  file.Close();
+}
+
+#endif
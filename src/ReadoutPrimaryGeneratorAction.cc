@@ -2,9 +2,13 @@
 
 #include <cmath>
 
+#include "AcceptanceFilter.hh"
+#include "EventInformation.hh"
 #include "G4SystemOfUnits.hh"
 #include "G4ParticleTable.hh"
 #include "G4ThreeVector.hh"
+#include "MomentumTable.hh"
+#include "PerfCounters.hh"
 
 ReadoutPrimaryGeneratorAction::ReadoutPrimaryGeneratorAction(
     const std::string& path)
@@ -17,38 +21,94 @@ ReadoutPrimaryGeneratorAction::ReadoutPrimaryGeneratorAction(
 
   m_file.open(path);
 
-  m_rng.seed(std::chrono::system_clock::now().time_since_epoch().count());
+  m_seed = std::chrono::system_clock::now().time_since_epoch().count();
+  m_rng.seed(m_seed);
 }
 
-void ReadoutPrimaryGeneratorAction::GeneratePrimaries(G4Event* event) {
-  m_particleGun->SetParticlePosition(G4ThreeVector(0, 0, 0));
+void ReadoutPrimaryGeneratorAction::rewind() {
+  m_file.clear();
+  m_file.seekg(0);
+  m_rng.seed(m_seed);
+}
+
+bool ReadoutPrimaryGeneratorAction::readMomentum(double& px, double& py,
+                                                 double& pz) {
+  if (m_momentumTable != nullptr) {
+    double momentum[3];
+    m_momentumTable->sample(m_rng, momentum);
+    px = momentum[0];
+    py = momentum[1];
+    pz = momentum[2];
+    return true;
+  }
 
   std::string s;
   char del = ',';
   if (!std::getline(m_file, s)) {
-    return;
+    return false;
   };
 
   std::stringstream stream(s);
   std::string res;
 
   std::getline(stream, res, del);
-  double px = std::stod(res);
+  px = std::stod(res);
 
   std::getline(stream, res, del);
-  double py = std::stod(res);
+  py = std::stod(res);
 
   std::getline(stream, res, del);
-  double pz = std::stod(res);
+  pz = std::stod(res);
+  return true;
+}
 
-  double gamma = std::sqrt(1 + px * px + py * py + pz * pz);
-  double E = gamma * 0.511 * MeV;
+void ReadoutPrimaryGeneratorAction::GeneratePrimaries(G4Event* event) {
+  PerfCounters::Scope scope(PerfCounters::Phase::kGeneration);
 
-  double P = std::sqrt(px * px + py * py + pz * pz);
-  G4ThreeVector dir(px, py, pz);
-  dir /= P;
+  m_particleGun->SetParticlePosition(G4ThreeVector(0, 0, 0));
 
-  m_particleGun->SetParticleEnergy(E);
-  m_particleGun->SetParticleMomentumDirection(dir);
-  m_particleGun->GeneratePrimaryVertex(event);
+  // One vertex per primary, the primaries get the track ids 1..K
+  AcceptanceFilter::Decision decision{1, false};
+  for (int k = 0; k < m_primariesPerEvent; k++) {
+    // The momenta skipped by the filter do not become primaries
+    double E;
+    G4ThreeVector dir;
+    do {
+      double px, py, pz;
+      if (!readMomentum(px, py, pz)) {
+        break;
+      }
+
+      double gamma = std::sqrt(1 + px * px + py * py + pz * pz);
+      E = gamma * 0.511 * MeV;
+
+      double P = std::sqrt(px * px + py * py + pz * pz);
+      dir = G4ThreeVector(px, py, pz);
+      dir /= P;
+
+      if (m_acceptanceFilter != nullptr) {
+        // Momentum of the simulated kinetic energy
+        double mass = m_particle->GetPDGMass();
+        double p = std::sqrt(E * E + 2 * E * mass);
+        decision = m_acceptanceFilter->decide(
+            G4ThreeVector(0, 0, 0), p * dir, m_particle->GetPDGCharge(),
+            std::uniform_real_distribution<>(0, 1)(m_rng));
+      }
+    } while (decision.weight == 0);
+    if (m_momentumTable == nullptr && !m_file) {
+      break;
+    }
+
+    m_particleGun->SetParticleEnergy(E);
+    m_particleGun->SetParticleMomentumDirection(dir);
+    m_particleGun->GeneratePrimaryVertex(event);
+  }
+
+  // The weight mode keeps one primary per event
+  if (m_acceptanceFilter != nullptr) {
+    auto information = new EventInformation();
+    information->weight = decision.weight;
+    information->outsideAcceptance = decision.outsideAcceptance;
+    event->SetUserInformation(information);
+  }
 }
@@ -0,0 +1,180 @@
+#include "RootSink.hh"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#include "TBasket.h"
+#include "TBranch.h"
+#include "TObjArray.h"
+#include "TParameter.h"
+
+RootSink::RootSink(const std::string& filePath, const std::string& treeName,
+                   const Config& cfg) {
+  m_file = new TFile(filePath.c_str(), "RECREATE");
+  if (cfg.compression >= 0) {
+    m_file->SetCompressionSettings(cfg.compression);
+  }
+  m_tree = new TTree(treeName.c_str(), treeName.c_str());
+  m_tree->SetAutoFlush(cfg.autoFlush);
+  m_tree->SetAutoSave(cfg.autoSave);
+}
+
+RootSink::RootSink(const std::string& filePath, const std::string& treeName,
+                   const PixelRecord& record, const Config& cfg)
+    : RootSink(filePath, treeName, cfg) {
+  m_record = &record;
+  m_compact = cfg.compactPrecision;
+
+  int bufSize = cfg.basketBytes;
+  int splitLvl = 0;
+
+  // The tree reads the record on Fill and leaves it unchanged
+  auto& r = const_cast<PixelRecord&>(record);
+
+  // Arrays of nHits, the addresses are set on every write
+  auto compactBranch = [&](CompactBranch& compact, const std::string& name,
+                           char type) {
+    compact.branch = m_tree->Branch(
+        name.c_str(), nullptr,
+        (name + "[nHits]/" + std::string(1, type)).c_str(), bufSize);
+  };
+
+  m_tree->Branch("geoId", &r.geoId, bufSize, splitLvl);
+  m_tree->Branch("pixIdX", &r.pixIdX, bufSize, splitLvl);
+  m_tree->Branch("pixIdY", &r.pixIdY, bufSize, splitLvl);
+
+  m_tree->Branch("isSignal", &r.isSignal, bufSize, splitLvl);
+
+  m_tree->Branch("geoCenterLocal", &r.geoCenterLocal, bufSize, splitLvl);
+  m_tree->Branch("geoCenterGlobal", &r.geoCenterGlobal, bufSize, splitLvl);
+
+  m_tree->Branch("totEDep", &r.totEDep, bufSize, splitLvl);
+
+  m_tree->Branch("parentTrackId", &r.parentTrackId, bufSize, splitLvl);
+  m_tree->Branch("trackId", &r.trackId, bufSize, splitLvl);
+  m_tree->Branch("primaryIdx", &r.primaryIdx, bufSize, splitLvl);
+  m_tree->Branch("eventId", &r.eventId, bufSize, splitLvl);
+  m_tree->Branch("runId", &r.runId, bufSize, splitLvl);
+  m_tree->Branch("eventWeight", &r.eventWeight, bufSize, splitLvl);
+
+  if (m_compact) {
+    m_tree->Branch("nHits", &m_nHits, "nHits/I", bufSize);
+  }
+  m_tree->Branch("hitPosGlobal", &r.hitPosGlobal, bufSize, splitLvl);
+  if (m_compact) {
+    compactBranch(m_hitOffsetLocal[0], "hitOffsetLocalX", 'S');
+    compactBranch(m_hitOffsetLocal[1], "hitOffsetLocalY", 'S');
+  } else {
+    m_tree->Branch("hitPosLocal", &r.hitPosLocal, bufSize, splitLvl);
+  }
+  m_tree->Branch("hitEntryPosGlobal", &r.hitEntryPosGlobal, bufSize,
+                 splitLvl);
+
+  if (m_compact) {
+    compactBranch(m_hitMomDir[0], "hitMomDirX", 'S');
+    compactBranch(m_hitMomDir[1], "hitMomDirY", 'S');
+    compactBranch(m_hitMomDir[2], "hitMomDirZ", 'S');
+  } else {
+    m_tree->Branch("hitMomDir", &r.hitMomDir, bufSize, splitLvl);
+  }
+  m_tree->Branch("hitE", &r.hitE, bufSize, splitLvl);
+  m_tree->Branch("hitP", &r.hitP, bufSize, splitLvl);
+
+  m_tree->Branch("ipMomDir", &r.ipMomDir, bufSize, splitLvl);
+  m_tree->Branch("ipE", &r.ipE, bufSize, splitLvl);
+  m_tree->Branch("ipP", &r.ipP, bufSize, splitLvl);
+  if (m_compact) {
+    compactBranch(m_vertex[0], "vertexX", 'd');
+    compactBranch(m_vertex[1], "vertexY", 'd');
+    compactBranch(m_vertex[2], "vertexZ", 'd');
+  } else {
+    m_tree->Branch("vertex", &r.vertex, bufSize, splitLvl);
+  }
+
+  m_tree->Branch("eDep", &r.eDep, bufSize, splitLvl);
+  m_tree->Branch("pdgId", &r.pdgId, bufSize, splitLvl);
+
+  m_tree->Branch("hitPrimaryE", &r.hitPrimaryE, bufSize, splitLvl);
+  m_tree->Branch("hitPrimaryTheta", &r.hitPrimaryTheta, bufSize, splitLvl);
+  m_tree->Branch("hitPrimaryPhi", &r.hitPrimaryPhi, bufSize, splitLvl);
+  m_tree->Branch("hitPrimaryWeight", &r.hitPrimaryWeight, bufSize,
+                 splitLvl);
+}
+
+RootSink::~RootSink() { close({}); }
+
+void RootSink::write() {
+  if (m_compact) {
+    fillCompact();
+  }
+  m_tree->Fill();
+}
+
+void RootSink::fillCompact() {
+  auto quantize = [](double value) {
+    return static_cast<Short_t>(
+        std::lround(std::clamp(value, -32767.0, 32767.0)));
+  };
+  const PixelRecord& r = *m_record;
+  m_nHits = static_cast<int>(r.hitPosLocal.size());
+  double center[2] = {r.geoCenterLocal.X(), r.geoCenterLocal.Y()};
+  for (int k = 0; k < 2; k++) {
+    std::vector<Short_t>& offsets = m_hitOffsetLocal[k].shorts;
+    offsets.resize(m_nHits);
+    for (int i = 0; i < m_nHits; i++) {
+      double position = k == 0 ? r.hitPosLocal[i].X() : r.hitPosLocal[i].Y();
+      offsets[i] = quantize((position - center[k]) / offsetQuantum);
+    }
+    m_hitOffsetLocal[k].branch->SetAddress(offsets.data());
+  }
+  for (int k = 0; k < 3; k++) {
+    std::vector<Short_t>& directions = m_hitMomDir[k].shorts;
+    std::vector<Double32_t>& vertices = m_vertex[k].doubles;
+    directions.resize(m_nHits);
+    vertices.resize(m_nHits);
+    for (int i = 0; i < m_nHits; i++) {
+      directions[i] = quantize(r.hitMomDir[i][k] * directionScale);
+      vertices[i] = r.vertex[i][k];
+    }
+    m_hitMomDir[k].branch->SetAddress(directions.data());
+    m_vertex[k].branch->SetAddress(vertices.data());
+  }
+}
+
+void RootSink::close(const Metadata& metadata) {
+  if (m_file == nullptr) {
+    return;
+  }
+  m_file->cd();
+  m_tree->Write();
+  for (const auto& [name, value] : metadata) {
+    TParameter<double>(name.c_str(), value).Write();
+  }
+  // The file owns the tree
+  m_file->Close();
+  delete m_file;
+  m_file = nullptr;
+  m_tree = nullptr;
+}
+
+std::uint64_t RootSink::bufferedBytes() const {
+  if (m_tree == nullptr) {
+    return 0;
+  }
+  std::uint64_t bytes = 0;
+  TObjArray* branches = m_tree->GetListOfBranches();
+  for (Int_t i = 0; i < branches->GetEntriesFast(); i++) {
+    auto* branch = static_cast<TBranch*>(branches->UncheckedAt(i));
+    if (TBasket* basket = branch->GetBasket(branch->GetWriteBasket())) {
+      bytes += basket->GetBufferSize();
+    }
+  }
+  return bytes;
+}
+
+void RootSink::flush() {
+  if (m_tree != nullptr) {
+    m_tree->FlushBaskets();
+  }
+}
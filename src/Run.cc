@@ -1,11 +1,15 @@
 #include "Run.hh"
 
+#include <algorithm>
 #include <cstddef>
 #include <unordered_map>
 
+#include "EventInformation.hh"
 #include "G4Event.hh"
 #include "G4Run.hh"
 #include "G4RunManager.hh"
+#include "PerfCounters.hh"
+#include "PixelGeometry.hh"
 #include "SamplingHit.hh"
 
 struct TupleHash {
@@ -17,58 +21,76 @@ struct TupleHash {
 };
 
 Run::Run(const std::string& filePath, const std::string& treeName,
-         double pixelThreshold)
-    : m_pixelThreshold(pixelThreshold) {
-  m_file = new TFile(filePath.c_str(), "RECREATE");
-  m_tree = new TTree(treeName.c_str(), treeName.c_str());
+         double pixelThreshold, const OutputSink::Config& outputCfg)
+    : m_sink(OutputSink::create(outputCfg, filePath, treeName, m_record)),
+      m_pixelThreshold(pixelThreshold) {}
 
-  int bufSize = 32000;
-  int splitLvl = 0;
-
-  m_tree->Branch("geoId", &m_geoId, bufSize, splitLvl);
-  m_tree->Branch("pixIdX", &m_pixIdX, bufSize, splitLvl);
-  m_tree->Branch("pixIdY", &m_pixIdY, bufSize, splitLvl);
-
-  m_tree->Branch("isSignal", &m_isSignal, bufSize, splitLvl);
-
-  m_tree->Branch("geoCenterLocal", &m_geoCenterLocal, bufSize, splitLvl);
-  m_tree->Branch("geoCenterGlobal", &m_geoCenterGlobal, bufSize, splitLvl);
-
-  m_tree->Branch("totEDep", &m_totEDep, bufSize, splitLvl);
-
-  m_tree->Branch("parentTrackId", &m_parentTrackId, bufSize, splitLvl);
-  m_tree->Branch("trackId", &m_trackId, bufSize, splitLvl);
-  m_tree->Branch("eventId", &m_eventId, bufSize, splitLvl);
-  m_tree->Branch("runId", &m_runId, bufSize, splitLvl);
-
-  m_tree->Branch("hitPosGlobal", &m_hitPosGlobal, bufSize, splitLvl);
-  m_tree->Branch("hitPosLocal", &m_hitPosLocal, bufSize, splitLvl);
-
-  m_tree->Branch("hitMomDir", &m_hitMomDir, bufSize, splitLvl);
-  m_tree->Branch("hitE", &m_hitE, bufSize, splitLvl);
-  m_tree->Branch("hitP", &m_hitP, bufSize, splitLvl);
-
-  m_tree->Branch("ipMomDir", &m_ipMomDir, bufSize, splitLvl);
-  m_tree->Branch("ipE", &m_ipE, bufSize, splitLvl);
-  m_tree->Branch("ipP", &m_ipP, bufSize, splitLvl);
-  m_tree->Branch("vertex", &m_vertex, bufSize, splitLvl);
+Run::~Run() {
+  // The counters of a reprocessed run, added before, are kept
+  auto addCounter = [&](const std::string& name, double value) {
+    if (std::none_of(m_metadata.begin(), m_metadata.end(),
+                     [&](const auto& entry) { return entry.first == name; })) {
+      addMetadata(name, value);
+    }
+  };
+  addCounter("numberOfEvents", numberOfEvent);
+  addCounter("weightedEventsWithHits", m_weightedEventsWithHits[0]);
+  addCounter("weightedEventsWithHitsOutsideAcceptance",
+             m_weightedEventsWithHits[1]);
+  PerfCounters::Scope scope(PerfCounters::Phase::kOutput);
+  m_sink->close(m_metadata);
+}
 
-  m_tree->Branch("eDep", &m_eDep, bufSize, splitLvl);
-  m_tree->Branch("pdgId", &m_pdgId, bufSize, splitLvl);
+void Run::addMetadata(const std::string& name, double value) {
+  m_metadata.emplace_back(name, value);
 }
 
-Run::~Run() {
-  m_tree->Write();
-  m_file->Close();
+std::uint64_t Run::bufferedBytes() const { return m_sink->bufferedBytes(); }
+
+void Run::flushOutput() {
+  PerfCounters::Scope scope(PerfCounters::Phase::kOutput);
+  m_sink->flush();
 }
 
 void Run::RecordEvent(const G4Event* event) {
+  PerfCounters::Scope scope(PerfCounters::Phase::kRecordEvent);
+  G4Run::RecordEvent(event);
+
   auto* hcOfThisEvent = event->GetHCofThisEvent();
   if (hcOfThisEvent == nullptr) {
     return;
   }
-  m_eventId = event->GetEventID();
-  m_runId = Run::GetRunID();
+  m_record.eventId = event->GetEventID();
+  m_record.runId = Run::GetRunID();
+
+  bool outsideAcceptance = false;
+  m_record.eventWeight = 1;
+  m_record.primaryE.clear();
+  m_record.primaryTheta.clear();
+  m_record.primaryPhi.clear();
+  m_record.primaryWeight.clear();
+  const std::vector<int>* originParentTrackId = nullptr;
+  if (const auto* information = dynamic_cast<const EventInformation*>(
+          event->GetUserInformation())) {
+    m_record.eventWeight = information->weight;
+    outsideAcceptance = information->outsideAcceptance;
+    m_record.primaryE = information->primaryE;
+    m_record.primaryTheta = information->primaryTheta;
+    m_record.primaryPhi = information->primaryPhi;
+    m_record.primaryWeight = information->primaryWeight;
+    if (!information->originParentTrackId.empty()) {
+      originParentTrackId = &information->originParentTrackId;
+    }
+  }
+  bool hasHits = false;
+
+  // Value of primary idx, or unknown where the generator does not
+  // record it
+  auto primaryValue = [](const std::vector<double>& values, int idx,
+                         double unknown) {
+    return idx >= 0 && idx < static_cast<int>(values.size()) ? values[idx]
+                                                             : unknown;
+  };
 
   std::size_t nCollections = hcOfThisEvent->GetNumberOfCollections();
   for (std::size_t i = 0; i < nCollections; i++) {
@@ -93,89 +115,148 @@ void Run::RecordEvent(const G4Event* event) {
       for (const auto* hit : hits) {
         totEDep += hit->GetEDep();
       }
-      m_totEDep = totEDep;
+      if (totEDep / PixelGeometry::pairProductionE < m_pixelThreshold) {
+        continue;
+      }
+      m_record.totEDep = totEDep;
+
+      m_record.parentTrackId.clear();
+      m_record.parentTrackId.reserve(hcSize);
+
+      m_record.trackId.clear();
+      m_record.trackId.reserve(hcSize);
+
+      m_record.primaryIdx.clear();
+      m_record.primaryIdx.reserve(hcSize);
 
-      m_parentTrackId.clear();
-      m_parentTrackId.reserve(hcSize);
+      m_record.hitPosGlobal.clear();
+      m_record.hitPosGlobal.reserve(hcSize);
 
-      m_trackId.clear();
-      m_trackId.reserve(hcSize);
+      m_record.hitPosLocal.clear();
+      m_record.hitPosLocal.reserve(hcSize);
 
-      m_hitPosGlobal.clear();
-      m_hitPosGlobal.reserve(hcSize);
+      m_record.hitEntryPosGlobal.clear();
+      m_record.hitEntryPosGlobal.reserve(hcSize);
 
-      m_hitPosLocal.clear();
-      m_hitPosLocal.reserve(hcSize);
+      m_record.hitMomDir.clear();
+      m_record.hitMomDir.reserve(hcSize);
 
-      m_hitMomDir.clear();
-      m_hitMomDir.reserve(hcSize);
+      m_record.hitE.clear();
+      m_record.hitE.reserve(hcSize);
 
-      m_hitE.clear();
-      m_hitE.reserve(hcSize);
+      m_record.hitP.clear();
+      m_record.hitP.reserve(hcSize);
 
-      m_hitP.clear();
-      m_hitP.reserve(hcSize);
+      m_record.ipMomDir.clear();
+      m_record.ipMomDir.reserve(hcSize);
 
-      m_ipMomDir.clear();
-      m_ipMomDir.reserve(hcSize);
+      m_record.ipE.clear();
+      m_record.ipE.reserve(hcSize);
 
-      m_ipE.clear();
-      m_ipE.reserve(hcSize);
+      m_record.ipP.clear();
+      m_record.ipP.reserve(hcSize);
 
-      m_ipP.clear();
-      m_ipP.reserve(hcSize);
+      m_record.vertex.clear();
+      m_record.vertex.reserve(hcSize);
 
-      m_vertex.clear();
-      m_vertex.reserve(hcSize);
+      m_record.eDep.clear();
+      m_record.eDep.reserve(hcSize);
 
-      m_eDep.clear();
-      m_eDep.reserve(hcSize);
+      m_record.pdgId.clear();
+      m_record.pdgId.reserve(hcSize);
 
-      m_pdgId.clear();
-      m_pdgId.reserve(hcSize);
+      m_record.hitPrimaryE.clear();
+      m_record.hitPrimaryE.reserve(hcSize);
 
-      std::tie(m_geoId, m_pixIdX, m_pixIdY) = id;
+      m_record.hitPrimaryTheta.clear();
+      m_record.hitPrimaryTheta.reserve(hcSize);
+
+      m_record.hitPrimaryPhi.clear();
+      m_record.hitPrimaryPhi.reserve(hcSize);
+
+      m_record.hitPrimaryWeight.clear();
+      m_record.hitPrimaryWeight.reserve(hcSize);
+
+      std::tie(m_record.geoId, m_record.pixIdX, m_record.pixIdY) = id;
 
       const auto* hitHandle = hits.at(0);
-      m_geoCenterLocal.SetX(hitHandle->GetPixCenterLocal().x());
-      m_geoCenterLocal.SetY(hitHandle->GetPixCenterLocal().y());
+      m_record.geoCenterLocal.SetX(hitHandle->GetPixCenterLocal().x());
+      m_record.geoCenterLocal.SetY(hitHandle->GetPixCenterLocal().y());
 
-      m_geoCenterGlobal.SetXYZ(hitHandle->GetPixCenterGlobal().x(),
-                             hitHandle->GetPixCenterGlobal().y(),
-                             hitHandle->GetPixCenterGlobal().z());
+      m_record.geoCenterGlobal.SetXYZ(hitHandle->GetPixCenterGlobal().x(),
+                                      hitHandle->GetPixCenterGlobal().y(),
+                                      hitHandle->GetPixCenterGlobal().z());
       for (const auto* hit : hits) {
-        m_isSignal = (hit->GetPdgId() == 11) && (hit->GetTrackId() == 1) &&
-                     (hit->GetParentTrackId() == 0);
-
-        m_parentTrackId.push_back(hit->GetParentTrackId());
-        m_trackId.push_back(hit->GetTrackId());
-
-        m_hitPosGlobal.emplace_back(hit->GetHitPosGlobal().x(),
-                                    hit->GetHitPosGlobal().y(),
-                                    hit->GetHitPosGlobal().z());
-        m_hitPosLocal.emplace_back(hit->GetHitPosLocal().x(),
-                                   hit->GetHitPosLocal().y());
-
-        m_hitMomDir.emplace_back(hit->GetMomDir().x(), hit->GetMomDir().y(),
-                                 hit->GetMomDir().z());
-        m_hitE.push_back(hit->GetETot());
-        m_hitP.push_back(hit->GetPTot());
-
-        m_ipMomDir.emplace_back(hit->GetMomDirIP().x(), hit->GetMomDirIP().y(),
-                                hit->GetMomDirIP().z());
-        m_ipE.push_back(hit->GetEIP());
-        m_ipP.push_back(hit->GetPIP());
-        m_vertex.emplace_back(hit->GetVertex().x(), hit->GetVertex().y(),
-                              hit->GetVertex().z());
-
-        m_eDep.push_back(hit->GetEDep());
-        m_pdgId.push_back(hit->GetPdgId());
+        // Primary k of a batched event has the track id k + 1. A
+        // replayed primary is signal only if it was the beam particle
+        // in stage one
+        int primaryIdx = hit->GetPrimaryIdx();
+        m_record.isSignal =
+            (hit->GetPdgId() == 11) && (hit->GetTrackId() == primaryIdx + 1) &&
+            (hit->GetParentTrackId() == 0) &&
+            (originParentTrackId == nullptr ||
+             (primaryIdx >= 0 &&
+              primaryIdx < static_cast<int>(originParentTrackId->size()) &&
+              (*originParentTrackId)[primaryIdx] == 0));
+
+        m_record.parentTrackId.push_back(hit->GetParentTrackId());
+        m_record.trackId.push_back(hit->GetTrackId());
+        m_record.primaryIdx.push_back(hit->GetPrimaryIdx());
+
+        m_record.hitPosGlobal.emplace_back(hit->GetHitPosGlobal().x(),
+                                           hit->GetHitPosGlobal().y(),
+                                           hit->GetHitPosGlobal().z());
+        m_record.hitPosLocal.emplace_back(hit->GetHitPosLocal().x(),
+                                          hit->GetHitPosLocal().y());
+        m_record.hitEntryPosGlobal.emplace_back(
+            hit->GetHitEntryPosGlobal().x(), hit->GetHitEntryPosGlobal().y(),
+            hit->GetHitEntryPosGlobal().z());
+
+        m_record.hitMomDir.emplace_back(hit->GetMomDir().x(),
+                                        hit->GetMomDir().y(),
+                                        hit->GetMomDir().z());
+        m_record.hitE.push_back(hit->GetETot());
+        m_record.hitP.push_back(hit->GetPTot());
+
+        // Track vertex, on the scoring plane for the particles
+        // replayed in stage two
+        m_record.ipMomDir.emplace_back(hit->GetMomDirIP().x(),
+                                       hit->GetMomDirIP().y(),
+                                       hit->GetMomDirIP().z());
+        m_record.ipE.push_back(hit->GetEIP());
+        m_record.ipP.push_back(hit->GetPIP());
+        m_record.vertex.emplace_back(hit->GetVertex().x(), hit->GetVertex().y(),
+                                     hit->GetVertex().z());
+
+        m_record.eDep.push_back(hit->GetEDep());
+        m_record.pdgId.push_back(hit->GetPdgId());
+
+        m_record.hitPrimaryE.push_back(
+            primaryValue(m_record.primaryE, primaryIdx, 0));
+        m_record.hitPrimaryTheta.push_back(
+            primaryValue(m_record.primaryTheta, primaryIdx, 0));
+        m_record.hitPrimaryPhi.push_back(
+            primaryValue(m_record.primaryPhi, primaryIdx, 0));
+        m_record.hitPrimaryWeight.push_back(primaryValue(
+            m_record.primaryWeight, primaryIdx, m_record.eventWeight));
       }
-      if (m_hitE.empty()) {
+      if (m_record.hitE.empty()) {
         continue;
       }
-      m_tree->Fill();
+      {
+        PerfCounters::Scope outputScope(PerfCounters::Phase::kOutput);
+        m_sink->write();
+      }
+      hasHits = true;
+    }
+  }
+
+  if (hasHits) {
+    {
+      PerfCounters::Scope outputScope(PerfCounters::Phase::kOutput);
+      m_sink->endEvent();
     }
+    m_weightedEventsWithHits[outsideAcceptance] += m_record.eventWeight;
   }
 }
 
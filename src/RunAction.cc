@@ -1,5 +1,12 @@
 #include "RunAction.hh"
 
+#include "AcceptanceFilter.hh"
+#include "G4RunManager.hh"
+#include "G4TransportationManager.hh"
+#include "MemoryMonitor.hh"
+#include "PerfCounters.hh"
+#include "Profiler.hh"
+#include "ProgressReporter.hh"
 #include "Run.hh"
 
 RunAction::RunAction(const std::string& filePath, const std::string& treeName,
@@ -10,9 +17,61 @@ RunAction::RunAction(const std::string& filePath, const std::string& treeName,
       G4UserRunAction() {}
 
 G4Run* RunAction::GenerateRun() {
-  return new Run(m_filePath, m_treeName, m_pixelThreshold);
+  return new Run(m_filePath, m_treeName, m_pixelThreshold, m_outputCfg);
 }
 
-void RunAction::BeginOfRunAction(const G4Run* run) {}
+void RunAction::BeginOfRunAction(const G4Run* run) {
+  if (m_profiler != nullptr) {
+    m_profiler->reset();
+  }
+  if (PerfCounters::enabled()) {
+    PerfCounters::resetAll();
+  }
+  if (m_memory != nullptr) {
+    m_memory->beginRun(static_cast<Run*>(
+        G4RunManager::GetRunManager()->GetNonConstCurrentRun()));
+  }
+  // Not for the runs building the physics tables alone
+  if (m_progress != nullptr && run->GetNumberOfEventToBeProcessed() > 0) {
+    m_progress->start(run->GetRunID(), run->GetNumberOfEventToBeProcessed(),
+                      m_filePath);
+  }
+  if (m_acceptanceFilter != nullptr) {
+    auto* navigator = G4TransportationManager::GetTransportationManager()
+                          ->GetNavigatorForTracking();
+    m_acceptanceFilter->update(navigator->GetWorldVolume());
+    m_acceptanceFilter->resetStats();
+  }
+}
 
-void RunAction::EndOfRunAction(const G4Run* run) {}
+void RunAction::EndOfRunAction(const G4Run* run) {
+  if (m_progress != nullptr) {
+    m_progress->stop();
+  }
+  if (m_profiler != nullptr) {
+    m_profiler->report();
+  }
+  if (PerfCounters::enabled() && run->GetNumberOfEvent() > 0) {
+    PerfCounters::report();
+  }
+  if (m_memory != nullptr) {
+    m_memory->endRun();
+  }
+  auto* currentRun =
+      static_cast<Run*>(G4RunManager::GetRunManager()->GetNonConstCurrentRun());
+  currentRun->addMetadata("primariesPerEvent", m_primariesPerEvent);
+  for (const auto& [name, value] : m_metadata) {
+    currentRun->addMetadata(name, value);
+  }
+  if (m_acceptanceFilter == nullptr) {
+    return;
+  }
+  const AcceptanceFilter::Stats& stats = m_acceptanceFilter->stats();
+  currentRun->addMetadata("acceptanceMargin",
+                          m_acceptanceFilter->config().margin);
+  currentRun->addMetadata("acceptanceGenerated", stats.generated);
+  currentRun->addMetadata("acceptanceAccepted", stats.accepted);
+  currentRun->addMetadata("acceptanceRejectedSimulated",
+                          stats.rejectedSimulated);
+  currentRun->addMetadata("acceptanceSkipped", stats.skipped);
+}
@@ -9,6 +9,7 @@
 #include "G4VisAttributes.hh"
 
 G4ThreadLocal G4Allocator<SamplingHit>* TrackerHitAllocator = nullptr;
+G4ThreadLocal SamplingHitPoolStats TrackerHitPoolStats;
 
 G4bool SamplingHit::operator==(const SamplingHit& right) const {
   return (this == &right) ? true : false;
@@ -9,6 +9,9 @@
 #include "G4String.hh"
 #include "G4ThreeVector.hh"
 #include "G4ios.hh"
+#include "PerfCounters.hh"
+#include "PixelGeometry.hh"
+#include "TrackInformation.hh"
 
 SamplingVolume::SamplingVolume(const G4String& name,
                                const G4String& hitsCollectionName,
@@ -28,6 +31,8 @@ void SamplingVolume::Initialize(G4HCofThisEvent* hce) {
 }
 
 bool SamplingVolume::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
+  PerfCounters::Scope scope(PerfCounters::Phase::kSensitiveDetector);
+
   auto newHit = new SamplingHit();
 
   int id = 100;
@@ -42,7 +47,9 @@ bool SamplingVolume::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
         std::string::npos) {
       id = 20;
     }
-    if (history->GetVolume(i)->GetName() == m_indexedVolumeName) {
+    // The indexed volumes are named <m_indexedVolumeName><copyNo>
+    if (history->GetVolume(i)->GetName().rfind(m_indexedVolumeName, 0) ==
+        0) {
       id += history->GetVolume(i)->GetCopyNo();
       break;
     }
@@ -54,20 +61,26 @@ bool SamplingVolume::ProcessHits(G4Step* aStep, G4TouchableHistory*) {
   newHit->SetParentTrackId(track->GetParentID());
   newHit->SetTrackId(track->GetTrackID());
   newHit->SetPdgId(track->GetParticleDefinition()->GetPDGEncoding());
+  if (const auto* information =
+          static_cast<const TrackInformation*>(track->GetUserInformation())) {
+    newHit->SetPrimaryIdx(information->primaryIdx);
+  }
 
   G4ThreeVector origin = touchable->GetTranslation();
   G4RotationMatrix rotation = *touchable->GetRotation();
   G4ThreeVector hitGlobal = aStep->GetPostStepPoint()->GetPosition();
-  G4ThreeVector hitLocal = rotation.inverse() * (hitGlobal - origin);
+  G4ThreeVector hitLocal =
+      PixelGeometry::toLocal(hitGlobal, origin, rotation);
   newHit->SetHitPosGlobal(hitGlobal);
   newHit->SetHitPosLocal({hitLocal.x(), hitLocal.y()});
+  newHit->SetHitEntryPosGlobal(aStep->GetPreStepPoint()->GetPosition());
 
-  int pixIdX = (hitLocal.x() + m_chipX / 2.0) / m_pixelX;
-  int pixIdY = (hitLocal.y() + m_chipY / 2.0) / m_pixelY;
+  int pixIdX = PixelGeometry::pixelIdX(hitLocal.x());
+  int pixIdY = PixelGeometry::pixelIdY(hitLocal.y());
 
-  G4TwoVector pixCenterLocal((pixIdX + 0.5) * m_pixelX - m_chipX / 2.0,
-                             (pixIdY + 0.5) * m_pixelY - m_chipY / 2.0);
-  G4ThreeVector pixCenterGlobal = rotation * pixCenterLocal + origin;
+  G4TwoVector pixCenterLocal = PixelGeometry::pixelCenter(pixIdX, pixIdY);
+  G4ThreeVector pixCenterGlobal =
+      PixelGeometry::toGlobal(pixCenterLocal, origin, rotation);
 
   newHit->SetPixCenterLocal(pixCenterLocal);
   newHit->SetPixCenterGlobal(pixCenterGlobal);
@@ -0,0 +1,7 @@
+#include "TrackInformation.hh"
+
+#include "G4ios.hh"
+
+void TrackInformation::Print() const {
+  G4cout << "primary index: " << primaryIdx << G4endl;
+}
@@ -8,7 +8,7 @@
 #include <G4Types.hh>
 
 #include "G4ExtrudedSolid.hh"
-#include "G4LogicalVolumeStore.hh"
+#include "G4Material.hh"
 #include "G4NistManager.hh"
 #include "G4PVPlacement.hh"
 #include "G4RotationMatrix.hh"
@@ -20,6 +20,8 @@
 
 G4VPhysicalVolume *TrackingChamberFactory::construct(
     G4LogicalVolume *logicParent, const Config &cfg) {
+  resetSharedVolumes(cfg);
+
   G4Material *protoTrackerContainerMaterial =
       G4NistManager::Instance()->FindOrBuildMaterial(
           cfg.gc->trackerContainerMaterial);
@@ -65,13 +67,16 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
 
   G4double holderOffset = 0.0 * mm;
   // Top holding panel
-  G4Box *solidProtoTrckHoldPanel =
-      new G4Box("solidProtoTrckHoldPanel", cfg.gc->ProtoTrackerHoldPanelX / 2.0,
-                cfg.gc->ProtoTrackerHoldPanelY / 2.0,
-                cfg.gc->ProtoTrackerHoldPanelZ / 2.0);
   G4LogicalVolume *logicProtoTrckHoldPanel =
-      new G4LogicalVolume(solidProtoTrckHoldPanel, protoTrackeBoxMaterial,
-                          "logicProtoTrckHoldPanel");
+      findOrBuild("logicProtoTrckHoldPanel", [&]() {
+        G4Box *solidProtoTrckHoldPanel = new G4Box(
+            "solidProtoTrckHoldPanel", cfg.gc->ProtoTrackerHoldPanelX / 2.0,
+            cfg.gc->ProtoTrackerHoldPanelY / 2.0,
+            cfg.gc->ProtoTrackerHoldPanelZ / 2.0);
+        return new G4LogicalVolume(solidProtoTrckHoldPanel,
+                                   protoTrackeBoxMaterial,
+                                   "logicProtoTrckHoldPanel");
+      });
   G4double hpxpos =
       0.5 * (protoTrckContainerX - cfg.gc->ProtoTrackerHoldPanelX) -
       cfg.gc->ProtoTrackerSidePanelX - cfg.gc->ProtoTrackerBoxCutX;
@@ -83,23 +88,32 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
                     logicProtoTrackerContainer, false, 0, cfg.checkOverlaps);
 
   // Front and back panels
-  G4Box *solidProtoTrckFBPanel1 = new G4Box(
-      "solidProtoTrckFBPanel1", cfg.gc->ProtoTrackerFBPanelX / 2.0,
-      cfg.gc->ProtoTrackerFBPanelY / 2.0, cfg.gc->ProtoTrackerFBPanelZ / 2.0);
-  G4Box *solidProtoTrckFBPanelCut = new G4Box(
-      "solidProtoTrckFBPanelCut", cfg.gc->ProtoTrackerFBPanelCutX / 2.0,
-      cfg.gc->ProtoTrackerFBPanelCutY / 2.0, cfg.gc->ProtoTrackerFBPanelZ);
-  G4Transform3D fbpcut(G4RotationMatrix(),
-                       G4ThreeVector(0.0,
-                                     0.5 * (cfg.gc->ProtoTrackerFBPanelCutY -
-                                            cfg.gc->ProtoTrackerFBPanelY) +
-                                         cfg.gc->ProtoTrackerFBPanelCutYpos,
-                                     0.0));
-  G4SubtractionSolid *solidProtoTrckFBPanel = new G4SubtractionSolid(
-      "solidProtoTrackerContainer", solidProtoTrckFBPanel1,
-      solidProtoTrckFBPanelCut, fbpcut);
-  G4LogicalVolume *logicProtoTrckFBPanel = new G4LogicalVolume(
-      solidProtoTrckFBPanel, protoTrackeBoxMaterial, "logicProtoTrckFBPanel");
+  G4LogicalVolume *logicProtoTrckFBPanel =
+      findOrBuild("logicProtoTrckFBPanel", [&]() {
+        G4Box *solidProtoTrckFBPanel1 =
+            new G4Box("solidProtoTrckFBPanel1",
+                      cfg.gc->ProtoTrackerFBPanelX / 2.0,
+                      cfg.gc->ProtoTrackerFBPanelY / 2.0,
+                      cfg.gc->ProtoTrackerFBPanelZ / 2.0);
+        G4Box *solidProtoTrckFBPanelCut =
+            new G4Box("solidProtoTrckFBPanelCut",
+                      cfg.gc->ProtoTrackerFBPanelCutX / 2.0,
+                      cfg.gc->ProtoTrackerFBPanelCutY / 2.0,
+                      cfg.gc->ProtoTrackerFBPanelZ);
+        G4Transform3D fbpcut(
+            G4RotationMatrix(),
+            G4ThreeVector(0.0,
+                          0.5 * (cfg.gc->ProtoTrackerFBPanelCutY -
+                                 cfg.gc->ProtoTrackerFBPanelY) +
+                              cfg.gc->ProtoTrackerFBPanelCutYpos,
+                          0.0));
+        G4SubtractionSolid *solidProtoTrckFBPanel = new G4SubtractionSolid(
+            "solidProtoTrackerContainer", solidProtoTrckFBPanel1,
+            solidProtoTrckFBPanelCut, fbpcut);
+        return new G4LogicalVolume(solidProtoTrckFBPanel,
+                                   protoTrackeBoxMaterial,
+                                   "logicProtoTrckFBPanel");
+      });
   G4double fpypos =
       0.5 * (protoTrckContainerY - cfg.gc->ProtoTrackerFBPanelY) - holderOffset;
   G4double fpzpos =
@@ -112,15 +126,18 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
                     logicProtoTrackerContainer, false, 1, cfg.checkOverlaps);
 
   // Kapton covering the cuts in front and back panels
-  G4Material *protoTrackerKaptonMaterial =
-      G4NistManager::Instance()->FindOrBuildMaterial("G4_KAPTON");
-  G4Box *solidProtoTrckKaptonCover =
-      new G4Box("solidProtoTrckKaptonCover", cfg.gc->ProtoTrackerFBPanelX / 2.0,
-                0.6 * cfg.gc->ProtoTrackerFBPanelCutY,
-                cfg.gc->ProtoTrckKaptonCoverZ / 2.0);
   G4LogicalVolume *logicProtoTrckKaptonCover =
-      new G4LogicalVolume(solidProtoTrckKaptonCover, protoTrackerKaptonMaterial,
-                          "logicProtoTrckKaptonCover");
+      findOrBuild("logicProtoTrckKaptonCover", [&]() {
+        G4Material *protoTrackerKaptonMaterial =
+            G4NistManager::Instance()->FindOrBuildMaterial("G4_KAPTON");
+        G4Box *solidProtoTrckKaptonCover = new G4Box(
+            "solidProtoTrckKaptonCover", cfg.gc->ProtoTrackerFBPanelX / 2.0,
+            0.6 * cfg.gc->ProtoTrackerFBPanelCutY,
+            cfg.gc->ProtoTrckKaptonCoverZ / 2.0);
+        return new G4LogicalVolume(solidProtoTrckKaptonCover,
+                                   protoTrackerKaptonMaterial,
+                                   "logicProtoTrckKaptonCover");
+      });
 
   G4double kapypos =
       fpypos +
@@ -136,13 +153,16 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
                     logicProtoTrackerContainer, false, 1, cfg.checkOverlaps);
 
   // Side panels
-  G4Box *solidProtoTrckSidePanel =
-      new G4Box("solidProtoTrckSidePanel", cfg.gc->ProtoTrackerSidePanelX / 2.0,
-                cfg.gc->ProtoTrackerSidePanelY / 2.0,
-                cfg.gc->ProtoTrackerSidePanelZ / 2.0);
   G4LogicalVolume *logicProtoTrckSidePanel =
-      new G4LogicalVolume(solidProtoTrckSidePanel, protoTrackeBoxMaterial,
-                          "logicProtoTrckSidePanel");
+      findOrBuild("logicProtoTrckSidePanel", [&]() {
+        G4Box *solidProtoTrckSidePanel = new G4Box(
+            "solidProtoTrckSidePanel", cfg.gc->ProtoTrackerSidePanelX / 2.0,
+            cfg.gc->ProtoTrackerSidePanelY / 2.0,
+            cfg.gc->ProtoTrackerSidePanelZ / 2.0);
+        return new G4LogicalVolume(solidProtoTrckSidePanel,
+                                   protoTrackeBoxMaterial,
+                                   "logicProtoTrckSidePanel");
+      });
   G4double spxpos = hpxpos + 0.5 * (cfg.gc->ProtoTrackerHoldPanelX +
                                     cfg.gc->ProtoTrackerSidePanelX);
   G4double spypos =
@@ -158,13 +178,16 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
                     logicProtoTrackerContainer, false, 1, cfg.checkOverlaps);
 
   // Bottom panel
-  G4Box *solidProtoTrckBottomPanel = new G4Box(
-      "solidProtoTrckBottomPanel", cfg.gc->ProtoTrackerBottomPanelX / 2.0,
-      cfg.gc->ProtoTrackerBottomPanelY / 2.0,
-      cfg.gc->ProtoTrackerBottomPanelZ / 2.0);
   G4LogicalVolume *logicProtoTrckBottomPanel =
-      new G4LogicalVolume(solidProtoTrckBottomPanel, protoTrackeBoxMaterial,
-                          "logicProtoTrckBottomPanel");
+      findOrBuild("logicProtoTrckBottomPanel", [&]() {
+        G4Box *solidProtoTrckBottomPanel = new G4Box(
+            "solidProtoTrckBottomPanel", cfg.gc->ProtoTrackerBottomPanelX / 2.0,
+            cfg.gc->ProtoTrackerBottomPanelY / 2.0,
+            cfg.gc->ProtoTrackerBottomPanelZ / 2.0);
+        return new G4LogicalVolume(solidProtoTrckBottomPanel,
+                                   protoTrackeBoxMaterial,
+                                   "logicProtoTrckBottomPanel");
+      });
   G4double bpxpos = 0.0;
   G4double bpypos =
       0.5 * (protoTrckContainerY - cfg.gc->ProtoTrackerBottomPanelY) -
@@ -193,44 +216,70 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
                     logicProtoTrackerContainer, false, 1, cfg.checkOverlaps);
 
   // LDO cover box
-  G4Box *solidProtoTrckLDOBox1 = new G4Box(
-      "solidProtoTrckLDOBox1", cfg.gc->ProtoTrackerLDOBoxX / 2.0,
-      cfg.gc->ProtoTrackerLDOBoxY / 2.0, cfg.gc->ProtoTrackerLDOBoxZ / 2.0);
   G4double ldocutx =
       cfg.gc->ProtoTrackerLDOBoxX - 2.0 * cfg.gc->ProtoTrackerLDOBoxD;
   G4double ldocutz =
       cfg.gc->ProtoTrackerLDOBoxZ - 2.0 * cfg.gc->ProtoTrackerLDOBoxD;
-  G4Box *solidProtoTrckLDOBoxCut =
-      new G4Box("solidProtoTrckLDOBoxCut", ldocutx / 2.0,
-                cfg.gc->ProtoTrackerLDOBoxY / 2.0, ldocutz / 2.0);
-  G4Transform3D ldotrcut(G4RotationMatrix(),
-                         G4ThreeVector(0.0, cfg.gc->ProtoTrackerLDOBoxD, 0.0));
-  G4SubtractionSolid *solidProtoTrckLDOBox =
-      new G4SubtractionSolid("solidProtoTrckLDOBox", solidProtoTrckLDOBox1,
-                             solidProtoTrckLDOBoxCut, ldotrcut);
-  G4LogicalVolume *logicProtoTrckLDOBox = new G4LogicalVolume(
-      solidProtoTrckLDOBox, protoTrackeBoxMaterial, "logicProtoTrckLDOBox");
-
   G4double ldoxpos = 0.5 * (protoTrckContainerX - cfg.gc->ProtoTrackerLDOBoxX) -
                      cfg.gc->ProtoTrackerLDOBoxXpos;
   G4double ldoypos = bpypos - 0.5 * (cfg.gc->ProtoTrackerLDOBoxY +
                                      cfg.gc->ProtoTrackerBottomPanelY);
-  new G4PVPlacement(0, G4ThreeVector(ldoxpos, ldoypos, 0.0),
-                    logicProtoTrckLDOBox, "ProtoTrckLDOBox",
-                    logicProtoTrackerContainer, false, 0, cfg.checkOverlaps);
-  // LDO PCB
-  G4Box *solidProtoTrckLDOPCB =
-      new G4Box("solidProtoTrckLDOPCB", ldocutx / 2.0,
-                cfg.gc->ProtoTrackerLDOPCBY / 2.0, ldocutz / 2.0);
-  G4LogicalVolume *logicProtoTrckLDOPCB = new G4LogicalVolume(
-      solidProtoTrckLDOPCB, trackerPCBMaterial, "logicProtoTrckLDOPCB");
-  G4double ldopcbypos =
-      ldoypos +
-      0.5 * (cfg.gc->ProtoTrackerLDOBoxY - cfg.gc->ProtoTrackerLDOPCBY) -
-      cfg.gc->ProtoTrackerLDOPCBYpos;
-  new G4PVPlacement(0, G4ThreeVector(ldoxpos, ldopcbypos, 0.0),
-                    logicProtoTrckLDOPCB, "ProtoTrckLDOPCB",
-                    logicProtoTrackerContainer, false, 0, cfg.checkOverlaps);
+  if (cfg.levelOfDetail == LevelOfDetail::kFast) {
+    // Cover box and the PCB inside it as a single block
+    G4double ldoBoxVolume =
+        cfg.gc->ProtoTrackerLDOBoxX * cfg.gc->ProtoTrackerLDOBoxY *
+            cfg.gc->ProtoTrackerLDOBoxZ -
+        ldocutx * (cfg.gc->ProtoTrackerLDOBoxY - cfg.gc->ProtoTrackerLDOBoxD) *
+            ldocutz;
+    G4double ldoPcbVolume = ldocutx * cfg.gc->ProtoTrackerLDOPCBY * ldocutz;
+    G4LogicalVolume *logicProtoTrckLDOBlock = constructHomogenizedBox(
+        "ProtoTrckLDOBlock", cfg.gc->ProtoTrackerLDOBoxX,
+        cfg.gc->ProtoTrackerLDOBoxY, cfg.gc->ProtoTrackerLDOBoxZ,
+        {{protoTrackeBoxMaterial, ldoBoxVolume},
+         {trackerPCBMaterial, ldoPcbVolume}});
+    new G4PVPlacement(0, G4ThreeVector(ldoxpos, ldoypos, 0.0),
+                      logicProtoTrckLDOBlock, "ProtoTrckLDOBlock",
+                      logicProtoTrackerContainer, false, 0, cfg.checkOverlaps);
+  } else {
+    G4LogicalVolume *logicProtoTrckLDOBox =
+        findOrBuild("logicProtoTrckLDOBox", [&]() {
+          G4Box *solidProtoTrckLDOBox1 = new G4Box(
+              "solidProtoTrckLDOBox1", cfg.gc->ProtoTrackerLDOBoxX / 2.0,
+              cfg.gc->ProtoTrackerLDOBoxY / 2.0,
+              cfg.gc->ProtoTrackerLDOBoxZ / 2.0);
+          G4Box *solidProtoTrckLDOBoxCut =
+              new G4Box("solidProtoTrckLDOBoxCut", ldocutx / 2.0,
+                        cfg.gc->ProtoTrackerLDOBoxY / 2.0, ldocutz / 2.0);
+          G4Transform3D ldotrcut(
+              G4RotationMatrix(),
+              G4ThreeVector(0.0, cfg.gc->ProtoTrackerLDOBoxD, 0.0));
+          G4SubtractionSolid *solidProtoTrckLDOBox = new G4SubtractionSolid(
+              "solidProtoTrckLDOBox", solidProtoTrckLDOBox1,
+              solidProtoTrckLDOBoxCut, ldotrcut);
+          return new G4LogicalVolume(solidProtoTrckLDOBox,
+                                     protoTrackeBoxMaterial,
+                                     "logicProtoTrckLDOBox");
+        });
+    new G4PVPlacement(0, G4ThreeVector(ldoxpos, ldoypos, 0.0),
+                      logicProtoTrckLDOBox, "ProtoTrckLDOBox",
+                      logicProtoTrackerContainer, false, 0, cfg.checkOverlaps);
+    // LDO PCB
+    G4LogicalVolume *logicProtoTrckLDOPCB =
+        findOrBuild("logicProtoTrckLDOPCB", [&]() {
+          G4Box *solidProtoTrckLDOPCB =
+              new G4Box("solidProtoTrckLDOPCB", ldocutx / 2.0,
+                        cfg.gc->ProtoTrackerLDOPCBY / 2.0, ldocutz / 2.0);
+          return new G4LogicalVolume(solidProtoTrckLDOPCB, trackerPCBMaterial,
+                                     "logicProtoTrckLDOPCB");
+        });
+    G4double ldopcbypos =
+        ldoypos +
+        0.5 * (cfg.gc->ProtoTrackerLDOBoxY - cfg.gc->ProtoTrackerLDOPCBY) -
+        cfg.gc->ProtoTrackerLDOPCBYpos;
+    new G4PVPlacement(0, G4ThreeVector(ldoxpos, ldopcbypos, 0.0),
+                      logicProtoTrckLDOPCB, "ProtoTrckLDOPCB",
+                      logicProtoTrackerContainer, false, 0, cfg.checkOverlaps);
+  }
 
   // Nine Alpide adapter PCB.
   G4AssemblyVolume *nineChipPcbAssy = constructNineAlpidePCB(cfg);
@@ -251,31 +300,21 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
                                            cfg.gc->ProtoTrackerPcieConY);
   for (int ii = 0; ii < sensor_pos_mask.size(); ++ii) {
     G4double carierzpos = cfg.gc->ProtoTrackerLayerDZ * (ii - 4.0);
-    G4LogicalVolume *carrierPcb = constructCarrierPCB(CarrierPcbContY, cfg, ii);
-    G4double carierypos =
-        ninepcbypos + 0.5 * (cfg.gc->ProtoTrackerNinePcbY + CarrierPcbContY);
 
     if (sensor_pos_mask.test(ii)) {
+      G4LogicalVolume *carrierPcb =
+          constructCarrierPCB(CarrierPcbContY, cfg, ii);
+      G4double carierypos =
+          ninepcbypos + 0.5 * (cfg.gc->ProtoTrackerNinePcbY + CarrierPcbContY);
       new G4PVPlacement(0, G4ThreeVector(carierxpos, carierypos, carierzpos),
                         carrierPcb, "ProtoTrckCarrierPCB" + std::to_string(ii),
                         logicProtoTrackerContainer, false, ii,
                         cfg.checkOverlaps);
     } else {
       // Carrier PCIE connctors
-      G4LogicalVolume *logicProtoTrackerPcieCon =
-          G4LogicalVolumeStore::GetInstance()->GetVolume(
-              "logicProtoTrackerPcieCon" + std::to_string(ii));
-      if (!logicProtoTrackerPcieCon) {
-        G4String msgstr(
-            "Logical volume of PCIE connctor is not found in the "
-            "G4LogicalVolumeStore.");
-        G4Exception("EttProtoTracker::", "Construct()", FatalException,
-                    msgstr.c_str());
-      }
-      new G4PVPlacement(0, G4ThreeVector(carierxpos, pcieypos, carierzpos),
-                        logicProtoTrackerPcieCon, "ProtoTrckPCIEConnector",
-                        logicProtoTrackerContainer, false, ii,
-                        cfg.checkOverlaps);
+      placePcieConnector(cfg, logicProtoTrackerContainer,
+                         G4ThreeVector(carierxpos, pcieypos, carierzpos),
+                         "ProtoTrckPCIEConnector", ii);
     }
   }
 
@@ -291,6 +330,27 @@ G4VPhysicalVolume *TrackingChamberFactory::construct(
   return physProtoTrackerContainer;
 }
 
+void TrackingChamberFactory::resetSharedVolumes(const Config &cfg) {
+  if (m_sharedGc == cfg.gc && m_sharedLevelOfDetail == cfg.levelOfDetail) {
+    return;
+  }
+  m_sharedVolumes.clear();
+  m_nineChipPcbAssembly = nullptr;
+  m_sharedGc = cfg.gc;
+  m_sharedLevelOfDetail = cfg.levelOfDetail;
+}
+
+G4LogicalVolume *TrackingChamberFactory::findOrBuild(
+    const std::string &name, const std::function<G4LogicalVolume *()> &build) {
+  auto it = m_sharedVolumes.find(name);
+  if (it != m_sharedVolumes.end()) {
+    return it->second;
+  }
+  G4LogicalVolume *logicVolume = build();
+  m_sharedVolumes.emplace(name, logicVolume);
+  return logicVolume;
+}
+
 G4LogicalVolume *TrackingChamberFactory::constructSensor(const Config &cfg,
                                                          int geometryId) {
   G4Material *sensorMaterial =
@@ -335,32 +395,36 @@ G4LogicalVolume *TrackingChamberFactory::constructSensor(const Config &cfg,
 
 G4LogicalVolume *TrackingChamberFactory::constructLConnector(
     const Config &cfg) {
-  G4Material *boxMaterial = G4NistManager::Instance()->FindOrBuildMaterial(
-      cfg.gc->ProtoTrackerBoxMaterial);
-
-  G4Box *solidProtoTrckLConnect1 =
-      new G4Box("solidProtoTrckLConnect1", cfg.gc->ProtoTrackerLConnectX / 2.0,
-                cfg.gc->ProtoTrackerLConnectYZ / 2.0,
-                cfg.gc->ProtoTrackerLConnectYZ / 2.0);
-  G4Box *solidProtoTrckLConnectCut =
-      new G4Box("solidProtoTrckLConnectCut", cfg.gc->ProtoTrackerLConnectX,
-                cfg.gc->ProtoTrackerLConnectYZ / 2.0,
-                cfg.gc->ProtoTrackerLConnectYZ / 2.0);
-  G4Transform3D trcut(G4RotationMatrix(),
-                      G4ThreeVector(0.0, cfg.gc->ProtoTrackerLConnectD,
-                                    cfg.gc->ProtoTrackerLConnectD));
-  G4SubtractionSolid *solidProtoTrckLConnect =
-      new G4SubtractionSolid("solidProtoTrckLConnect", solidProtoTrckLConnect1,
-                             solidProtoTrckLConnectCut, trcut);
-
-  G4LogicalVolume *logicProtoTrckLConnect = new G4LogicalVolume(
-      solidProtoTrckLConnect, boxMaterial, "logicProtoTrckLConnect");
-
-  return logicProtoTrckLConnect;
+  return findOrBuild("logicProtoTrckLConnect", [&]() {
+    G4Material *boxMaterial = G4NistManager::Instance()->FindOrBuildMaterial(
+        cfg.gc->ProtoTrackerBoxMaterial);
+
+    G4Box *solidProtoTrckLConnect1 = new G4Box(
+        "solidProtoTrckLConnect1", cfg.gc->ProtoTrackerLConnectX / 2.0,
+        cfg.gc->ProtoTrackerLConnectYZ / 2.0,
+        cfg.gc->ProtoTrackerLConnectYZ / 2.0);
+    G4Box *solidProtoTrckLConnectCut = new G4Box(
+        "solidProtoTrckLConnectCut", cfg.gc->ProtoTrackerLConnectX,
+        cfg.gc->ProtoTrackerLConnectYZ / 2.0,
+        cfg.gc->ProtoTrackerLConnectYZ / 2.0);
+    G4Transform3D trcut(G4RotationMatrix(),
+                        G4ThreeVector(0.0, cfg.gc->ProtoTrackerLConnectD,
+                                      cfg.gc->ProtoTrackerLConnectD));
+    G4SubtractionSolid *solidProtoTrckLConnect = new G4SubtractionSolid(
+        "solidProtoTrckLConnect", solidProtoTrckLConnect1,
+        solidProtoTrckLConnectCut, trcut);
+
+    return new G4LogicalVolume(solidProtoTrckLConnect, boxMaterial,
+                               "logicProtoTrckLConnect");
+  });
 }
 
 G4AssemblyVolume *TrackingChamberFactory::constructNineAlpidePCB(
     const Config &cfg) {
+  if (m_nineChipPcbAssembly) {
+    return m_nineChipPcbAssembly;
+  }
+
   G4Material *trackerPCBMaterial =
       G4NistManager::Instance()->FindOrBuildMaterial(
           cfg.gc->trackerPCBMaterial);
@@ -376,26 +440,41 @@ G4AssemblyVolume *TrackingChamberFactory::constructNineAlpidePCB(
   G4LogicalVolume *logicProtoTrck9ChipPcb = new G4LogicalVolume(
       solidProtoTrck9ChipPcb, trackerPCBMaterial, "logicProtoTrck9ChipPcb");
   // Power connectors
-  G4Box *solidProtoTrck9ChipPcbCon1 = new G4Box(
-      "solidProtoTrck9ChipPcbCon1", cfg.gc->ProtoTrackerNinePcbConX / 2.0,
-      cfg.gc->ProtoTrackerNinePcbConY / 2.0,
-      cfg.gc->ProtoTrackerNinePcbConZ / 2.0);
   G4double concutx =
       cfg.gc->ProtoTrackerNinePcbConX - 2.0 * cfg.gc->ProtoTrackerNinePcbConD;
   G4double concutz =
       cfg.gc->ProtoTrackerNinePcbConZ - 2.0 * cfg.gc->ProtoTrackerNinePcbConD;
-  G4Box *solidProtoTrck9ChipPcbConCut =
-      new G4Box("solidProtoTrck9ChipPcbConCut", concutx / 2.0,
-                cfg.gc->ProtoTrackerNinePcbConY / 2.0, concutz / 2.0);
-  G4Transform3D contrcut(
-      G4RotationMatrix(),
-      G4ThreeVector(0.0, -cfg.gc->ProtoTrackerNinePcbConD, 0.0));
-  G4SubtractionSolid *solidProtoTrck9ChipPcbCon = new G4SubtractionSolid(
-      "solidProtoTrck9ChipPcbCon", solidProtoTrck9ChipPcbCon1,
-      solidProtoTrck9ChipPcbConCut, contrcut);
-  G4LogicalVolume *logicProtoTrck9ChipPcbCon =
-      new G4LogicalVolume(solidProtoTrck9ChipPcbCon, trackerPowerConMaterial,
-                          "logicProtoTrck9ChipPcbCon");
+  G4LogicalVolume *logicProtoTrck9ChipPcbCon = nullptr;
+  if (cfg.levelOfDetail == LevelOfDetail::kFast) {
+    G4double conVolume =
+        cfg.gc->ProtoTrackerNinePcbConX * cfg.gc->ProtoTrackerNinePcbConY *
+            cfg.gc->ProtoTrackerNinePcbConZ -
+        concutx *
+            (cfg.gc->ProtoTrackerNinePcbConY -
+             cfg.gc->ProtoTrackerNinePcbConD) *
+            concutz;
+    logicProtoTrck9ChipPcbCon = constructHomogenizedBox(
+        "ProtoTrck9ChipPcbConBlock", cfg.gc->ProtoTrackerNinePcbConX,
+        cfg.gc->ProtoTrackerNinePcbConY, cfg.gc->ProtoTrackerNinePcbConZ,
+        {{trackerPowerConMaterial, conVolume}});
+  } else {
+    G4Box *solidProtoTrck9ChipPcbCon1 = new G4Box(
+        "solidProtoTrck9ChipPcbCon1", cfg.gc->ProtoTrackerNinePcbConX / 2.0,
+        cfg.gc->ProtoTrackerNinePcbConY / 2.0,
+        cfg.gc->ProtoTrackerNinePcbConZ / 2.0);
+    G4Box *solidProtoTrck9ChipPcbConCut =
+        new G4Box("solidProtoTrck9ChipPcbConCut", concutx / 2.0,
+                  cfg.gc->ProtoTrackerNinePcbConY / 2.0, concutz / 2.0);
+    G4Transform3D contrcut(
+        G4RotationMatrix(),
+        G4ThreeVector(0.0, -cfg.gc->ProtoTrackerNinePcbConD, 0.0));
+    G4SubtractionSolid *solidProtoTrck9ChipPcbCon = new G4SubtractionSolid(
+        "solidProtoTrck9ChipPcbCon", solidProtoTrck9ChipPcbCon1,
+        solidProtoTrck9ChipPcbConCut, contrcut);
+    logicProtoTrck9ChipPcbCon =
+        new G4LogicalVolume(solidProtoTrck9ChipPcbCon, trackerPowerConMaterial,
+                            "logicProtoTrck9ChipPcbCon");
+  }
 
   G4ThreeVector pcbtr(0.0, 0.0, 0.0);
   nineChipPcbAssembly->AddPlacedVolume(logicProtoTrck9ChipPcb, pcbtr, 0);
@@ -412,9 +491,96 @@ G4AssemblyVolume *TrackingChamberFactory::constructNineAlpidePCB(
   contr.setZ(-contrz);
   nineChipPcbAssembly->AddPlacedVolume(logicProtoTrck9ChipPcbCon, contr, 0);
 
+  m_nineChipPcbAssembly = nineChipPcbAssembly;
   return nineChipPcbAssembly;
 }
 
+G4LogicalVolume *TrackingChamberFactory::constructPcieConnector(
+    const Config &cfg) {
+  return findOrBuild("logicProtoTrackerPcieCon", [&]() {
+    G4Material *trackerPcieConMaterial =
+        G4NistManager::Instance()->FindOrBuildMaterial(
+            cfg.gc->trackerNinePcbConMaterial);
+
+    G4Box *solidProtoTrackerPcieCon1 = new G4Box(
+        "solidProtoTrackerPcieCon1", cfg.gc->ProtoTrackerPcieConX / 2.0,
+        cfg.gc->ProtoTrackerPcieConY / 2.0, cfg.gc->ProtoTrackerPcieConZ / 2.0);
+    G4double pcieccutx =
+        cfg.gc->ProtoTrkCarrierPcbX - 2.0 * cfg.gc->ProtoTrkCarrierPcbBCutX;
+    G4Box *solidProtoTrackerPcieConCut = new G4Box(
+        "solidProtoTrackerPcieConCut", pcieccutx / 2.0,
+        cfg.gc->ProtoTrackerPcieConY, cfg.gc->ProtoTrkCarrierPcbZ / 2.0);
+    G4Transform3D pcietrcut(G4RotationMatrix(), G4ThreeVector(0.0, 0.0, 0.0));
+    G4SubtractionSolid *solidProtoTrackerPcieCon = new G4SubtractionSolid(
+        "solidProtoTrackerPcieCon", solidProtoTrackerPcieCon1,
+        solidProtoTrackerPcieConCut, pcietrcut);
+    return new G4LogicalVolume(solidProtoTrackerPcieCon, trackerPcieConMaterial,
+                               "logicProtoTrackerPcieCon");
+  });
+}
+
+void TrackingChamberFactory::placePcieConnector(const Config &cfg,
+                                                G4LogicalVolume *logicParent,
+                                                const G4ThreeVector &position,
+                                                const std::string &name,
+                                                int copyNo) {
+  if (cfg.levelOfDetail == LevelOfDetail::kDetailed) {
+    new G4PVPlacement(0, position, constructPcieConnector(cfg), name,
+                      logicParent, false, copyNo, cfg.checkOverlaps);
+    return;
+  }
+
+  // Two slabs on both sides of the carrier PCB slot
+  G4Material *trackerPcieConMaterial =
+      G4NistManager::Instance()->FindOrBuildMaterial(
+          cfg.gc->trackerNinePcbConMaterial);
+  G4double pcieccutx =
+      cfg.gc->ProtoTrkCarrierPcbX - 2.0 * cfg.gc->ProtoTrkCarrierPcbBCutX;
+  G4double pcieVolume = cfg.gc->ProtoTrackerPcieConX *
+                            cfg.gc->ProtoTrackerPcieConY *
+                            cfg.gc->ProtoTrackerPcieConZ -
+                        pcieccutx * cfg.gc->ProtoTrackerPcieConY *
+                            cfg.gc->ProtoTrkCarrierPcbZ;
+  G4double slabz =
+      0.5 * (cfg.gc->ProtoTrackerPcieConZ - cfg.gc->ProtoTrkCarrierPcbZ);
+  G4LogicalVolume *logicProtoTrackerPcieConSlab = constructHomogenizedBox(
+      "ProtoTrackerPcieConSlab", cfg.gc->ProtoTrackerPcieConX,
+      cfg.gc->ProtoTrackerPcieConY, slabz,
+      {{trackerPcieConMaterial, 0.5 * pcieVolume}});
+
+  G4ThreeVector slabShift(0.0, 0.0,
+                          0.5 * (cfg.gc->ProtoTrkCarrierPcbZ + slabz));
+  new G4PVPlacement(0, position - slabShift, logicProtoTrackerPcieConSlab,
+                    name, logicParent, false, copyNo, cfg.checkOverlaps);
+  new G4PVPlacement(0, position + slabShift, logicProtoTrackerPcieConSlab,
+                    name, logicParent, false, copyNo, cfg.checkOverlaps);
+}
+
+G4LogicalVolume *TrackingChamberFactory::constructHomogenizedBox(
+    const std::string &name, G4double x, G4double y, G4double z,
+    const std::vector<std::pair<G4Material *, G4double>> &components) {
+  return findOrBuild("logic" + name, [&]() {
+    G4Box *solidBox = new G4Box("solid" + name, x / 2.0, y / 2.0, z / 2.0);
+
+    // Materials outlive the geometry, so a rebuild reuses them
+    std::string materialName = name + "Material";
+    G4Material *boxMaterial = G4Material::GetMaterial(materialName, false);
+    if (!boxMaterial) {
+      G4double mass = 0;
+      for (const auto &[material, volume] : components) {
+        mass += material->GetDensity() * volume;
+      }
+      boxMaterial = new G4Material(materialName, mass / (x * y * z),
+                                   static_cast<G4int>(components.size()));
+      for (const auto &[material, volume] : components) {
+        boxMaterial->AddMaterial(material,
+                                 material->GetDensity() * volume / mass);
+      }
+    }
+    return new G4LogicalVolume(solidBox, boxMaterial, "logic" + name);
+  });
+}
+
 G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
     G4double &carrierPcbContainerY, const Config &cfg, int nCarrier) {
   G4Material *protoTrackerContainerMaterial =
@@ -423,9 +589,6 @@ G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
   G4Material *carierPCBMaterial =
       G4NistManager::Instance()->FindOrBuildMaterial(
           cfg.gc->trackerPCBMaterial);
-  G4Material *trackerPcieConMaterial =
-      G4NistManager::Instance()->FindOrBuildMaterial(
-          cfg.gc->trackerNinePcbConMaterial);
   G4Material *trackerPcieHoldMaterial =
       G4NistManager::Instance()->FindOrBuildMaterial(
           cfg.gc->ProtoTrackerPEEKMaterial);
@@ -434,6 +597,9 @@ G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
       cfg.gc->ProtoTrackerFBPanelY + cfg.gc->ProtoTrackerBottomPanelY -
       cfg.gc->ProtoTrackerBottomPanelYposShift + cfg.gc->ProtoTrackerLDOBoxY;
 
+  // The container holds the aligned sensor, so it is
+  // the only part of the carrier built per chamber
+  int sensGeoId = cfg.geoIdPrefix + nCarrier;
   G4double ccontx = cfg.gc->ProtoTrkCarrierPcbX;
   G4double cconty = protoTrckContainerY - cfg.gc->ProtoTrackerBoxCutY -
                     cfg.gc->ProtoTrackerHoldPanelY;
@@ -442,55 +608,61 @@ G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
       "solidCarrierPcbContainer", ccontx / 2.0, cconty / 2.0, ccontz / 2.0);
   G4LogicalVolume *logicCarrierPcbContainer = new G4LogicalVolume(
       solidCarrierPcbContainer, protoTrackerContainerMaterial,
-      "logicCarrierPcbContainer" + std::to_string(nCarrier));
+      "logicCarrierPcbContainer" + std::to_string(sensGeoId));
 
   // Carrier PCB
-  G4Box *solidCarrierPcb1 = new G4Box(
-      "solidCarrierPcb1", cfg.gc->ProtoTrkCarrierPcbX / 2.0,
-      cfg.gc->ProtoTrkCarrierPcbY / 2.0, cfg.gc->ProtoTrkCarrierPcbZ / 2.0);
-  G4Box *solidCarrPcbCut1 =
-      new G4Box("solidCarrPcbCut1", cfg.gc->ProtoTrkCarrierPcbBCutX,
-                cfg.gc->ProtoTrkCarrierPcbBCutY, cfg.gc->ProtoTrkCarrierPcbZ);
-
-  G4double y1 =
-      cfg.gc->ProtoTrkCarrierPcbCutY - cfg.gc->ProtoTrkCarrierPcbACutXY;
-  G4double x2 = cfg.gc->ProtoTrkCarrierPcbACutXY;
-  G4double y2 = cfg.gc->ProtoTrkCarrierPcbCutY;
-  G4double x3 =
-      cfg.gc->ProtoTrkCarrierPcbCutX - cfg.gc->ProtoTrkCarrierPcbACutXY;
-  G4double x4 = cfg.gc->ProtoTrkCarrierPcbCutX;
-  std::vector<G4TwoVector> cutvtx{G4TwoVector(0.0, 0.0), G4TwoVector(0.0, y1),
-                                  G4TwoVector(x2, y2),   G4TwoVector(x3, y2),
-                                  G4TwoVector(x4, y1),   G4TwoVector(x4, 0.0)};
-
-  G4ExtrudedSolid *solidCarrPcbCut2 = new G4ExtrudedSolid(
-      "solidCarrPcbCut2", cutvtx, cfg.gc->ProtoTrkCarrierPcbZ,
-      G4TwoVector(0, 0), 1.0, G4TwoVector(0, 0), 1.0);
-
-  G4Transform3D trmcut(G4RotationMatrix(),
-                       G4ThreeVector(cfg.gc->ProtoTrkCarrierPcbCutXpos -
-                                         cfg.gc->ProtoTrkCarrierPcbX / 2.0,
-                                     cfg.gc->ProtoTrkCarrierPcbY / 2.0 -
-                                         cfg.gc->ProtoTrkCarrierPcbCutYpos -
-                                         cfg.gc->ProtoTrkCarrierPcbCutY,
-                                     0.0));
-  G4SubtractionSolid *solidCarrierPcb2 = new G4SubtractionSolid(
-      "solidCarrierPcb2", solidCarrierPcb1, solidCarrPcbCut2, trmcut);
-
-  G4Transform3D trmcut1(G4RotationMatrix(),
-                        G4ThreeVector(-cfg.gc->ProtoTrkCarrierPcbX / 2.0,
-                                      -cfg.gc->ProtoTrkCarrierPcbY / 2.0, 0.0));
-  G4SubtractionSolid *solidCarrierPcb3 = new G4SubtractionSolid(
-      "solidCarrierPcb3", solidCarrierPcb2, solidCarrPcbCut1, trmcut1);
-
-  G4Transform3D trmcut2(G4RotationMatrix(),
-                        G4ThreeVector(cfg.gc->ProtoTrkCarrierPcbX / 2.0,
-                                      -cfg.gc->ProtoTrkCarrierPcbY / 2.0, 0.0));
-  G4SubtractionSolid *solidCarrierPcb = new G4SubtractionSolid(
-      "solidCarrierPcb", solidCarrierPcb3, solidCarrPcbCut1, trmcut2);
-
-  G4LogicalVolume *logicCarrierPcb = new G4LogicalVolume(
-      solidCarrierPcb, carierPCBMaterial, "logicCarrierPcb");
+  G4LogicalVolume *logicCarrierPcb = findOrBuild("logicCarrierPcb", [&]() {
+    G4Box *solidCarrierPcb1 = new G4Box(
+        "solidCarrierPcb1", cfg.gc->ProtoTrkCarrierPcbX / 2.0,
+        cfg.gc->ProtoTrkCarrierPcbY / 2.0, cfg.gc->ProtoTrkCarrierPcbZ / 2.0);
+    G4Box *solidCarrPcbCut1 =
+        new G4Box("solidCarrPcbCut1", cfg.gc->ProtoTrkCarrierPcbBCutX,
+                  cfg.gc->ProtoTrkCarrierPcbBCutY, cfg.gc->ProtoTrkCarrierPcbZ);
+
+    G4double y1 =
+        cfg.gc->ProtoTrkCarrierPcbCutY - cfg.gc->ProtoTrkCarrierPcbACutXY;
+    G4double x2 = cfg.gc->ProtoTrkCarrierPcbACutXY;
+    G4double y2 = cfg.gc->ProtoTrkCarrierPcbCutY;
+    G4double x3 =
+        cfg.gc->ProtoTrkCarrierPcbCutX - cfg.gc->ProtoTrkCarrierPcbACutXY;
+    G4double x4 = cfg.gc->ProtoTrkCarrierPcbCutX;
+    std::vector<G4TwoVector> cutvtx{
+        G4TwoVector(0.0, 0.0), G4TwoVector(0.0, y1), G4TwoVector(x2, y2),
+        G4TwoVector(x3, y2),   G4TwoVector(x4, y1),  G4TwoVector(x4, 0.0)};
+
+    G4ExtrudedSolid *solidCarrPcbCut2 = new G4ExtrudedSolid(
+        "solidCarrPcbCut2", cutvtx, cfg.gc->ProtoTrkCarrierPcbZ,
+        G4TwoVector(0, 0), 1.0, G4TwoVector(0, 0), 1.0);
+
+    G4Transform3D trmcut(
+        G4RotationMatrix(),
+        G4ThreeVector(
+            cfg.gc->ProtoTrkCarrierPcbCutXpos -
+                cfg.gc->ProtoTrkCarrierPcbX / 2.0,
+            cfg.gc->ProtoTrkCarrierPcbY / 2.0 -
+                cfg.gc->ProtoTrkCarrierPcbCutYpos -
+                cfg.gc->ProtoTrkCarrierPcbCutY,
+            0.0));
+    G4SubtractionSolid *solidCarrierPcb2 = new G4SubtractionSolid(
+        "solidCarrierPcb2", solidCarrierPcb1, solidCarrPcbCut2, trmcut);
+
+    G4Transform3D trmcut1(
+        G4RotationMatrix(),
+        G4ThreeVector(-cfg.gc->ProtoTrkCarrierPcbX / 2.0,
+                      -cfg.gc->ProtoTrkCarrierPcbY / 2.0, 0.0));
+    G4SubtractionSolid *solidCarrierPcb3 = new G4SubtractionSolid(
+        "solidCarrierPcb3", solidCarrierPcb2, solidCarrPcbCut1, trmcut1);
+
+    G4Transform3D trmcut2(
+        G4RotationMatrix(),
+        G4ThreeVector(cfg.gc->ProtoTrkCarrierPcbX / 2.0,
+                      -cfg.gc->ProtoTrkCarrierPcbY / 2.0, 0.0));
+    G4SubtractionSolid *solidCarrierPcb = new G4SubtractionSolid(
+        "solidCarrierPcb", solidCarrierPcb3, solidCarrPcbCut1, trmcut2);
+
+    return new G4LogicalVolume(solidCarrierPcb, carierPCBMaterial,
+                               "logicCarrierPcb");
+  });
 
   G4double crpcbypos = 0.5 * (cfg.gc->ProtoTrkCarrierPcbY - cconty) +
                        cfg.gc->ProtoTrackerPcieConGapY;
@@ -499,7 +671,6 @@ G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
                     cfg.checkOverlaps);
 
   // Alpide sensor
-  int sensGeoId = cfg.geoIdPrefix + nCarrier;
   G4LogicalVolume *logicAlpideSensor = constructSensor(cfg, sensGeoId);
   G4double sensypos =
       crpcbypos + 0.5 * (cfg.gc->ProtoTrkCarrierPcbY - cfg.gc->OPPPSensorY) -
@@ -513,25 +684,10 @@ G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
             << physAlpideSensor->GetTranslation() << "\n\n\n";
 
   // PCIE connector
-  G4Box *solidProtoTrackerPcieCon1 = new G4Box(
-      "solidProtoTrackerPcieCon1", cfg.gc->ProtoTrackerPcieConX / 2.0,
-      cfg.gc->ProtoTrackerPcieConY / 2.0, cfg.gc->ProtoTrackerPcieConZ / 2.0);
-  G4double pcieccutx =
-      cfg.gc->ProtoTrkCarrierPcbX - 2.0 * cfg.gc->ProtoTrkCarrierPcbBCutX;
-  G4Box *solidProtoTrackerPcieConCut = new G4Box(
-      "solidProtoTrackerPcieConCut", pcieccutx / 2.0,
-      cfg.gc->ProtoTrackerPcieConY, cfg.gc->ProtoTrkCarrierPcbZ / 2.0);
-  G4Transform3D pcietrcut(G4RotationMatrix(), G4ThreeVector(0.0, 0.0, 0.0));
-  G4SubtractionSolid *solidProtoTrackerPcieCon = new G4SubtractionSolid(
-      "solidProtoTrackerPcieCon", solidProtoTrackerPcieCon1,
-      solidProtoTrackerPcieConCut, pcietrcut);
-  G4LogicalVolume *logicProtoTrackerPcieCon = new G4LogicalVolume(
-      solidProtoTrackerPcieCon, trackerPcieConMaterial,
-      "logicProtoTrackerPcieCon" + std::to_string(nCarrier));
   G4double pcieypos = 0.5 * (cfg.gc->ProtoTrackerPcieConY - cconty);
-  new G4PVPlacement(0, G4ThreeVector(0.0, pcieypos, 0.0),
-                    logicProtoTrackerPcieCon, "ProtoTrackerPcieConnector",
-                    logicCarrierPcbContainer, false, 0, cfg.checkOverlaps);
+  placePcieConnector(cfg, logicCarrierPcbContainer,
+                     G4ThreeVector(0.0, pcieypos, 0.0),
+                     "ProtoTrackerPcieConnector", 0);
 
   // Carrier PCB PEEK holder
   G4double carrierHolderX = cfg.gc->ProtoTrkCarrierPcbX;
@@ -540,26 +696,31 @@ G4LogicalVolume *TrackingChamberFactory::constructCarrierPCB(
       std::min(0.5 * (ccontz - cfg.gc->ProtoTrkCarrierPcbZ),
                cfg.gc->ProtoTrackerCarrierHoldZ);
 
-  G4Box *solidProtoTrackerCarrierHold1 =
-      new G4Box("solidProtoTrackerCarrierHold1", carrierHolderX / 2.0,
-                carrierHolderY / 2.0, carrierHolderZ / 2.0);
-
-  G4double carrierHolderCutX =
-      carrierHolderX - 2.0 * cfg.gc->ProtoTrackerCarrierHoldD;
-  G4Box *solidProtoTrackerCarrierHoldCut =
-      new G4Box("solidProtoTrackerCarrierHoldCut", carrierHolderCutX / 2.0,
-                carrierHolderY / 2.0, carrierHolderZ);
-  G4double chCutYpos = cconty - cfg.gc->ProtoTrackerPcieConGapY -
-                       cfg.gc->ProtoTrkCarrierPcbY +
-                       cfg.gc->ProtoTrackerCarrierHoldD;
-  G4Transform3D chtrcut(G4RotationMatrix(),
-                        G4ThreeVector(0.0, -chCutYpos, 0.0));
-  G4SubtractionSolid *solidProtoTrackerCarrierHold = new G4SubtractionSolid(
-      "solidProtoTrackerCarrierHold", solidProtoTrackerCarrierHold1,
-      solidProtoTrackerCarrierHoldCut, chtrcut);
   G4LogicalVolume *logicProtoTrackerCarrierHold =
-      new G4LogicalVolume(solidProtoTrackerCarrierHold, trackerPcieHoldMaterial,
-                          "logicProtoTrackerCarrierHold");
+      findOrBuild("logicProtoTrackerCarrierHold", [&]() {
+        G4Box *solidProtoTrackerCarrierHold1 =
+            new G4Box("solidProtoTrackerCarrierHold1", carrierHolderX / 2.0,
+                      carrierHolderY / 2.0, carrierHolderZ / 2.0);
+
+        G4double carrierHolderCutX =
+            carrierHolderX - 2.0 * cfg.gc->ProtoTrackerCarrierHoldD;
+        G4Box *solidProtoTrackerCarrierHoldCut =
+            new G4Box("solidProtoTrackerCarrierHoldCut",
+                      carrierHolderCutX / 2.0, carrierHolderY / 2.0,
+                      carrierHolderZ);
+        G4double chCutYpos = cconty - cfg.gc->ProtoTrackerPcieConGapY -
+                             cfg.gc->ProtoTrkCarrierPcbY +
+                             cfg.gc->ProtoTrackerCarrierHoldD;
+        G4Transform3D chtrcut(G4RotationMatrix(),
+                              G4ThreeVector(0.0, -chCutYpos, 0.0));
+        G4SubtractionSolid *solidProtoTrackerCarrierHold =
+            new G4SubtractionSolid("solidProtoTrackerCarrierHold",
+                                   solidProtoTrackerCarrierHold1,
+                                   solidProtoTrackerCarrierHoldCut, chtrcut);
+        return new G4LogicalVolume(solidProtoTrackerCarrierHold,
+                                   trackerPcieHoldMaterial,
+                                   "logicProtoTrackerCarrierHold");
+      });
 
   G4double chypos = 0.5 * (cconty - carrierHolderY);
   G4double chzpos = 0.5 * (cfg.gc->ProtoTrkCarrierPcbZ + carrierHolderZ);
@@ -1,5 +1,10 @@
 #include "VacuumChamberFactory.hh"
 
+#include <algorithm>
+#include <cmath>
+
+#include "G4Box.hh"
+#include "G4ExtrudedSolid.hh"
 #include "G4MultiUnion.hh"
 #include "G4NistManager.hh"
 #include "G4PVPlacement.hh"
@@ -12,8 +17,54 @@
 #include "G4VSolid.hh"
 #include "G4VisAttributes.hh"
 
+namespace {
+
+/// Point at the given radius and angle from the first exit normal
+G4TwoVector polarPoint(G4double radius, G4double phi) {
+  return G4TwoVector(radius * std::sin(phi), -radius * std::cos(phi));
+}
+
+/// Point at the given distance along and across the normal of the exit
+G4TwoVector exitPoint(G4double across, G4double along, G4double exitAngle) {
+  G4TwoVector point(across, -along);
+  point.rotate(exitAngle);
+  return point;
+}
+
+/// Append the arc vertices between the end points, so that
+/// the chords deviate from the arc by less than the tolerance
+void appendArc(std::vector<G4TwoVector> &polygon, G4double radius,
+               G4double phiStart, G4double phiEnd, G4double tolerance) {
+  G4double maxStep = 2.0 * std::acos(1.0 - tolerance / radius);
+  int nSteps =
+      static_cast<int>(std::ceil(std::abs(phiEnd - phiStart) / maxStep));
+  for (int i = 1; i < nSteps; i++) {
+    polygon.push_back(
+        polarPoint(radius, phiStart + (phiEnd - phiStart) * i / nSteps));
+  }
+}
+
+/// G4ExtrudedSolid takes the vertices in clockwise order
+void makeClockwise(std::vector<G4TwoVector> &polygon) {
+  G4double area = 0;
+  for (std::size_t i = 0; i < polygon.size(); i++) {
+    const G4TwoVector &a = polygon.at(i);
+    const G4TwoVector &b = polygon.at((i + 1) % polygon.size());
+    area += a.x() * b.y() - b.x() * a.y();
+  }
+  if (area > 0) {
+    std::reverse(polygon.begin(), polygon.end());
+  }
+}
+
+}  // namespace
+
 G4VPhysicalVolume *VacuumChamberFactory::construct(G4LogicalVolume *logicParent,
                                                    const Config &cfg) {
+  if (cfg.solidModel == SolidModel::kNative) {
+    return constructNative(logicParent, cfg);
+  }
+
   G4Material *vcVacuumMaterial =
       G4NistManager::Instance()->FindOrBuildMaterial(cfg.gc->vcVacuumMaterial);
   G4Material *vcWallsMaterial =
@@ -359,3 +410,288 @@ std::pair<G4VSolid *, G4VSolid *> VacuumChamberFactory::constructVcFlange(
 
   return {solidVcFlangeMilled, solidVcFlange};
 }
+
+G4VPhysicalVolume *VacuumChamberFactory::constructNative(
+    G4LogicalVolume *logicParent, const Config &cfg) {
+  G4Material *vcVacuumMaterial =
+      G4NistManager::Instance()->FindOrBuildMaterial(cfg.gc->vcVacuumMaterial);
+  G4Material *vcWallsMaterial =
+      G4NistManager::Instance()->FindOrBuildMaterial(cfg.gc->vcWallsMaterial);
+  G4Material *vcDoorsMaterial =
+      G4NistManager::Instance()->FindOrBuildMaterial(cfg.gc->vcDoorsMaterial);
+  G4Material *vcWindowsMaterial =
+      G4NistManager::Instance()->FindOrBuildMaterial(cfg.gc->vcWindowsMaterial);
+  G4Material *vcFlangeMaterial =
+      G4NistManager::Instance()->FindOrBuildMaterial(cfg.gc->vcFlangeMaterial);
+
+  // Without the vacuum mother the space between the chamber
+  // parts is filled with the parent material
+  if (logicParent->GetMaterial() != vcVacuumMaterial) {
+    G4Exception("VacuumChamberFactory::", "constructNative()", JustWarning,
+                "The VC vacuum differs from the parent material, the native "
+                "model fills only the chamber bore with the vacuum.");
+  }
+
+  G4VisAttributes *vcVacuumVis = new G4VisAttributes(G4Color::Green());
+  vcVacuumVis->SetVisibility(false);
+  G4VisAttributes *vcWallsVis = new G4VisAttributes(G4Color::Blue());
+  G4VisAttributes *vcexitVis = new G4VisAttributes(G4Color::Red());
+
+  // The parts are placed in the parent with the
+  // transformations they have in the boolean model
+  G4RotationMatrix vcRotation;
+  vcRotation.rotateX(cfg.vcRotationAngleX);
+  vcRotation.rotateY(cfg.vcRotationAngleY);
+  vcRotation.rotateZ(cfg.vcRotationAngleZ);
+  G4Transform3D vcTransform(
+      vcRotation.inverse(),
+      G4ThreeVector(cfg.vcCenterX, cfg.vcCenterY, cfg.vcCenterZ));
+
+  G4RotationMatrix vcExitsRotation;
+  vcExitsRotation.rotateX(-cfg.vcRotationAngleX);
+  vcExitsRotation.rotateY(-cfg.vcRotationAngleY);
+  vcExitsRotation.rotateZ(-cfg.vcRotationAngleZ);
+  G4Transform3D vcDoorsTransform =
+      vcTransform *
+      G4Transform3D(vcExitsRotation.inverse(),
+                    G4ThreeVector(cfg.vcCenterX, cfg.vcCenterY, cfg.vcCenterZ));
+  G4Transform3D vcFlangeTransform =
+      vcTransform * G4Transform3D(vcExitsRotation.inverse(), G4ThreeVector());
+
+  G4double tolerance = cfg.gc->vcArcTolerance;
+
+  // ---------------------------------------------------
+  // Vacuum in the chamber bore
+
+  // The wall polygons cut the bore arc by up to the tolerance
+  G4Tubs *solidVcVacuum =
+      new G4Tubs(cfg.name, 0, cfg.gc->vcCylinderRadMin - tolerance,
+                 cfg.gc->vcCylinderHalfZ, 0 * rad, 2 * M_PI * rad);
+  G4LogicalVolume *logicVcVacuum =
+      new G4LogicalVolume(solidVcVacuum, vcVacuumMaterial, cfg.name);
+  logicVcVacuum->SetVisAttributes(vcVacuumVis);
+
+  G4VPhysicalVolume *physVcVacuum =
+      new G4PVPlacement(vcTransform, logicVcVacuum, cfg.name, logicParent,
+                        false, 0, cfg.checkOverlaps);
+
+  // ---------------------------------------------------
+  // VC walls
+
+  // Walls between the exits over the full cutout height
+  std::vector<G4TwoVector> pillarPolygon = constructWallPillarPolygon(cfg);
+  G4ExtrudedSolid *solidVcWallPillar = new G4ExtrudedSolid(
+      "VcWallPillar", pillarPolygon, cfg.gc->vcCylinderCutoutHalfY,
+      G4TwoVector(0, 0), 1.0, G4TwoVector(0, 0), 1.0);
+  G4LogicalVolume *logicVcWallPillar =
+      new G4LogicalVolume(solidVcWallPillar, vcWallsMaterial, "VcWallPillar");
+  logicVcWallPillar->SetVisAttributes(vcWallsVis);
+
+  // Walls above and below the doors
+  G4double lintelHalfZ =
+      (cfg.gc->vcCylinderCutoutHalfY - cfg.gc->vcDoorHalfY) / 2;
+  G4double lintelZ = (cfg.gc->vcCylinderCutoutHalfY + cfg.gc->vcDoorHalfY) / 2;
+  std::vector<G4TwoVector> lintelPolygon = constructWallLintelPolygon(cfg);
+  G4ExtrudedSolid *solidVcWallLintel =
+      new G4ExtrudedSolid("VcWallLintel", lintelPolygon, lintelHalfZ,
+                          G4TwoVector(0, 0), 1.0, G4TwoVector(0, 0), 1.0);
+  G4LogicalVolume *logicVcWallLintel =
+      new G4LogicalVolume(solidVcWallLintel, vcWallsMaterial, "VcWallLintel");
+  logicVcWallLintel->SetVisAttributes(vcWallsVis);
+
+  for (std::size_t i = 0; i < 8; i++) {
+    G4RotationMatrix exitRotation;
+    exitRotation.rotateZ(i * cfg.gc->vcExitAngleSpacing);
+
+    new G4PVPlacement(
+        vcTransform * G4Transform3D(exitRotation, G4ThreeVector()),
+        logicVcWallPillar, "VcWalls", logicParent, false, i,
+        cfg.checkOverlaps);
+    new G4PVPlacement(
+        vcTransform * G4Transform3D(exitRotation, G4ThreeVector(0, 0, lintelZ)),
+        logicVcWallLintel, "VcWalls", logicParent, false, 2 * i,
+        cfg.checkOverlaps);
+    new G4PVPlacement(
+        vcTransform *
+            G4Transform3D(exitRotation, G4ThreeVector(0, 0, -lintelZ)),
+        logicVcWallLintel, "VcWalls", logicParent, false, 2 * i + 1,
+        cfg.checkOverlaps);
+  }
+
+  // Full cylinder beyond the cutouts
+  G4double ringHalfZ =
+      (cfg.gc->vcCylinderHalfZ - cfg.gc->vcCylinderCutoutHalfY) / 2;
+  G4double ringZ =
+      (cfg.gc->vcCylinderHalfZ + cfg.gc->vcCylinderCutoutHalfY) / 2;
+  G4Tubs *solidVcWallRing =
+      new G4Tubs("VcWallRing", cfg.gc->vcCylinderRadMin,
+                 cfg.gc->vcCylinderRadMin + cfg.gc->vcCylinderThickness,
+                 ringHalfZ, 0 * rad, 2 * M_PI * rad);
+  G4LogicalVolume *logicVcWallRing =
+      new G4LogicalVolume(solidVcWallRing, vcWallsMaterial, "VcWallRing");
+  logicVcWallRing->SetVisAttributes(vcWallsVis);
+
+  new G4PVPlacement(
+      vcTransform * G4Translate3D(0, 0, ringZ), logicVcWallRing, "VcWalls",
+      logicParent, false, 0, cfg.checkOverlaps);
+  new G4PVPlacement(
+      vcTransform * G4Translate3D(0, 0, -ringZ), logicVcWallRing, "VcWalls",
+      logicParent, false, 1, cfg.checkOverlaps);
+
+  // ---------------------------------------------------
+  // VC doors and windows
+
+  // The windows start inside the door cutouts, the
+  // part overlapping the door is placed in the cutout
+  G4double doorOuterZ = cfg.gc->vcDoorCenterZ + cfg.gc->vcDoorHalfZ;
+  G4double windowInnerZ = cfg.gc->vcWindowCenterZ - cfg.gc->vcWindowHalfZ;
+  G4double windowOuterZ = cfg.gc->vcWindowCenterZ + cfg.gc->vcWindowHalfZ;
+  G4double windowInDoorHalfZ = std::max(0.0, doorOuterZ - windowInnerZ) / 2;
+  G4double windowOutDoorHalfZ =
+      (windowOuterZ - std::max(doorOuterZ, windowInnerZ)) / 2;
+
+  G4Box *solidVcDoor = new G4Box("VcDoor", cfg.gc->vcDoorHalfX,
+                                 cfg.gc->vcDoorHalfY, cfg.gc->vcDoorHalfZ);
+  G4ThreeVector vcDoorTranslation(cfg.gc->vcDoorCenterX, cfg.gc->vcDoorCenterY,
+                                  cfg.gc->vcDoorCenterZ);
+  G4RotationMatrix vcDoorRotation = G4RotationMatrix::IDENTITY;
+  for (std::size_t i = 0; i < 8; i++) {
+    G4double windowRad = (i == 0 || i == 7) ? cfg.gc->bigVcWindowRad
+                                             : cfg.gc->smallVcWindowRad;
+    // Only the first window holds the flange
+    G4double windowRadMin = (i == 0) ? cfg.gc->vcFlangeRad : 0;
+
+    G4LogicalVolume *logicVcDoor =
+        new G4LogicalVolume(solidVcDoor, vcDoorsMaterial, "VcDoor");
+    logicVcDoor->SetVisAttributes(vcexitVis);
+
+    G4Tubs *solidVcDoorCutout =
+        new G4Tubs("VcDoorCutout", 0, windowRad, cfg.gc->vcDoorHalfZ, 0 * rad,
+                   2 * M_PI * rad);
+    G4LogicalVolume *logicVcDoorCutout = new G4LogicalVolume(
+        solidVcDoorCutout, vcVacuumMaterial, "VcDoorCutout");
+    logicVcDoorCutout->SetVisAttributes(vcVacuumVis);
+    new G4PVPlacement(nullptr, G4ThreeVector(), logicVcDoorCutout,
+                      "VcDoorCutout", logicVcDoor, false, i,
+                      cfg.checkOverlaps);
+
+    if (windowInDoorHalfZ > 0) {
+      G4Tubs *solidVcWindowInDoor =
+          new G4Tubs("VcWindowInDoor", windowRadMin, windowRad,
+                     windowInDoorHalfZ, 0 * rad, 2 * M_PI * rad);
+      G4LogicalVolume *logicVcWindowInDoor = new G4LogicalVolume(
+          solidVcWindowInDoor, vcWindowsMaterial, "VcWindowInDoor");
+      logicVcWindowInDoor->SetVisAttributes(vcexitVis);
+      new G4PVPlacement(
+          nullptr,
+          G4ThreeVector(0, 0, cfg.gc->vcDoorHalfZ - windowInDoorHalfZ),
+          logicVcWindowInDoor, "VcWindows", logicVcDoorCutout, false, i,
+          cfg.checkOverlaps);
+    }
+
+    G4Tubs *solidVcWindow =
+        new G4Tubs("VcWindow", windowRadMin, windowRad, windowOutDoorHalfZ,
+                   0 * rad, 2 * M_PI * rad);
+    G4LogicalVolume *logicVcWindow =
+        new G4LogicalVolume(solidVcWindow, vcWindowsMaterial, "VcWindow");
+    logicVcWindow->SetVisAttributes(vcexitVis);
+
+    G4ThreeVector vcWindowTranslation(cfg.gc->vcWindowCenterX,
+                                      cfg.gc->vcWindowCenterY,
+                                      windowOuterZ - windowOutDoorHalfZ);
+
+    new G4PVPlacement(
+        vcDoorsTransform * G4Transform3D(vcDoorRotation,
+                                         vcDoorRotation * vcDoorTranslation),
+        logicVcDoor, "VcDoors", logicParent, false, i, cfg.checkOverlaps);
+    new G4PVPlacement(
+        vcDoorsTransform * G4Transform3D(vcDoorRotation,
+                                         vcDoorRotation * vcWindowTranslation),
+        logicVcWindow, "VcWindows", logicParent, false, i, cfg.checkOverlaps);
+
+    vcDoorRotation.rotateY(cfg.gc->vcExitAngleSpacing);
+  }
+
+  // ---------------------------------------------------
+  // VC flange
+
+  G4Tubs *solidVcFlange =
+      new G4Tubs("VcFlange", 0, cfg.gc->vcFlangeRad, cfg.gc->vcFlangeHalfZ,
+                 0 * rad, 2 * M_PI * rad);
+  G4LogicalVolume *logicVcFlangeWindow =
+      new G4LogicalVolume(solidVcFlange, vcFlangeMaterial, "VcFlangeWindow");
+  logicVcFlangeWindow->SetVisAttributes(vcexitVis);
+
+  // Milled pocket leaving the thin exit window
+  G4double pocketHalfZ = cfg.gc->vcFlangeHalfZ - cfg.gc->vcFlangeWindowHalfZ;
+  G4Box *solidVcFlangePocket =
+      new G4Box("VcFlangePocket", cfg.gc->vcFlangeWindowHalfX,
+                cfg.gc->vcFlangeWindowHalfY, pocketHalfZ);
+  G4LogicalVolume *logicVcFlangePocket = new G4LogicalVolume(
+      solidVcFlangePocket, vcVacuumMaterial, "VcFlangePocket");
+  logicVcFlangePocket->SetVisAttributes(vcVacuumVis);
+
+  G4RotationMatrix pocketRotation = G4RotationMatrix::IDENTITY;
+  pocketRotation.rotateZ(M_PI_4);
+  new G4PVPlacement(
+      G4Transform3D(pocketRotation,
+                    G4ThreeVector(0, 0, pocketHalfZ - cfg.gc->vcFlangeHalfZ)),
+      logicVcFlangePocket, "VcFlangePocket", logicVcFlangeWindow, false, 0,
+      cfg.checkOverlaps);
+
+  new G4PVPlacement(
+      vcFlangeTransform * G4Translate3D(cfg.gc->vcFlangeCenterX,
+                                        cfg.gc->vcFlangeCenterY,
+                                        cfg.gc->vcFlangeCenterZ),
+      logicVcFlangeWindow, "VcFlangeWindow", logicParent, false, 0,
+      cfg.checkOverlaps);
+
+  return physVcVacuum;
+}
+
+std::vector<G4TwoVector> VacuumChamberFactory::constructWallPillarPolygon(
+    const Config &cfg) {
+  G4double radMin = cfg.gc->vcCylinderRadMin;
+  G4double radMax = cfg.gc->vcCylinderRadMin + cfg.gc->vcCylinderThickness;
+  G4double flat = radMax - cfg.gc->vcCylinderCutoutHalfZ;
+  G4double spacing = cfg.gc->vcExitAngleSpacing;
+
+  G4double doorPhi = std::asin(cfg.gc->vcDoorHalfX / radMin);
+  G4double cutoutPhi = std::asin(cfg.gc->vcCylinderCutoutHalfX / radMax);
+
+  // From the door edge of the first exit along the
+  // cutout and the outer arc to the second exit
+  std::vector<G4TwoVector> polygon{
+      polarPoint(radMin, doorPhi),
+      exitPoint(cfg.gc->vcDoorHalfX, flat, 0),
+      exitPoint(cfg.gc->vcCylinderCutoutHalfX, flat, 0),
+      polarPoint(radMax, cutoutPhi)};
+  appendArc(polygon, radMax, cutoutPhi, spacing - cutoutPhi,
+            cfg.gc->vcArcTolerance);
+  polygon.push_back(polarPoint(radMax, spacing - cutoutPhi));
+  polygon.push_back(exitPoint(-cfg.gc->vcCylinderCutoutHalfX, flat, spacing));
+  polygon.push_back(exitPoint(-cfg.gc->vcDoorHalfX, flat, spacing));
+  polygon.push_back(polarPoint(radMin, spacing - doorPhi));
+  appendArc(polygon, radMin, spacing - doorPhi, doorPhi,
+            cfg.gc->vcArcTolerance);
+
+  makeClockwise(polygon);
+  return polygon;
+}
+
+std::vector<G4TwoVector> VacuumChamberFactory::constructWallLintelPolygon(
+    const Config &cfg) {
+  G4double radMin = cfg.gc->vcCylinderRadMin;
+  G4double radMax = cfg.gc->vcCylinderRadMin + cfg.gc->vcCylinderThickness;
+  G4double flat = radMax - cfg.gc->vcCylinderCutoutHalfZ;
+
+  G4double doorPhi = std::asin(cfg.gc->vcDoorHalfX / radMin);
+
+  std::vector<G4TwoVector> polygon{
+      polarPoint(radMin, -doorPhi), exitPoint(-cfg.gc->vcDoorHalfX, flat, 0),
+      exitPoint(cfg.gc->vcDoorHalfX, flat, 0), polarPoint(radMin, doorPhi)};
+  appendArc(polygon, radMin, doorPhi, -doorPhi, cfg.gc->vcArcTolerance);
+
+  makeClockwise(polygon);
+  return polygon;
+}
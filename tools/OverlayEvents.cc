@@ -0,0 +1,477 @@
+// Builds high occupancy readout frames from a library of single
+// particle events. Every frame mixes a Poisson distributed number of
+// library particles at the pixel level: the deposits of the hits on a
+// shared pixel are summed and the pixel threshold is applied to the
+// sum. One library therefore serves every beam intensity.
+//
+// The library is the output of the simulation without a threshold;
+// batched events are split into their primaries. Only the particles
+// with hits are stored, so the numberOfEvents and primariesPerEvent
+// (or acceptanceGenerated) metadata of the library turns the mean
+// into the mean number of particles that leave hits. The particles
+// are drawn with replacement and get their position in the frame as
+// primaryIdx; a frame is a function of the seed and its index only,
+// whatever the thread count.
+//
+// Usage: alWindowOverlay <library.root> <output.root> <mean> <nFrames>
+//                        [threshold[e]] [nThreads] [seed] [treeName]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4TwoVector.hh"
+#include "HitPrecisionReader.hh"
+#include "PixelGeometry.hh"
+#include "Run.hh"
+#include "SamplingHit.hh"
+#include "TFile.h"
+#include "TParameter.h"
+#include "TTree.h"
+#include "TVector2.h"
+#include "TVector3.h"
+
+namespace {
+
+struct LibraryHit {
+  int geoId;
+  int pixIdX;
+  int pixIdY;
+  int parentTrackId;
+  int trackId;
+  int pdgId;
+  int primaryIdx;
+
+  G4TwoVector pixCenterLocal;
+  G4ThreeVector pixCenterGlobal;
+
+  G4ThreeVector hitPosGlobal;
+  G4TwoVector hitPosLocal;
+  G4ThreeVector hitEntryPosGlobal;
+
+  G4ThreeVector momDir;
+  double eTot;
+  double pTot;
+
+  G4ThreeVector momDirIP;
+  double eIP;
+  double pIP;
+  G4ThreeVector vertex;
+
+  double eDep;
+};
+
+/// Hits of all library particles, particle i owns the hits
+/// [eventBegin[i], eventBegin[i + 1])
+struct Library {
+  std::vector<LibraryHit> hits;
+  std::vector<std::size_t> eventBegin;
+  /// A hit of the library has a primary weight other than 1
+  bool weighted = false;
+
+  std::size_t nEvents() const { return eventBegin.size() - 1; }
+};
+
+double readParameter(TFile& file, const char* name, double fallback) {
+  auto* parameter = file.Get<TParameter<double>>(name);
+  return parameter != nullptr ? parameter->GetVal() : fallback;
+}
+
+bool readLibrary(TFile& input, const std::string& treeName,
+                 Library& library) {
+  auto* tree = input.Get<TTree>(treeName.c_str());
+  if (tree == nullptr) {
+    return false;
+  }
+
+  int geoId, pixIdX, pixIdY, eventId, runId;
+  TVector2* geoCenterLocal = nullptr;
+  TVector3* geoCenterGlobal = nullptr;
+  std::vector<int>* parentTrackId = nullptr;
+  std::vector<int>* trackId = nullptr;
+  std::vector<int>* pdgId = nullptr;
+  std::vector<int>* primaryIdx = nullptr;
+  std::vector<TVector3>* hitPosGlobal = nullptr;
+  std::vector<TVector3>* hitEntryPosGlobal = nullptr;
+  std::vector<TVector3>* ipMomDir = nullptr;
+  std::vector<double>* hitE = nullptr;
+  std::vector<double>* hitP = nullptr;
+  std::vector<double>* ipE = nullptr;
+  std::vector<double>* ipP = nullptr;
+  std::vector<double>* eDep = nullptr;
+  std::vector<double>* hitPrimaryWeight = nullptr;
+  tree->SetBranchAddress("geoId", &geoId);
+  tree->SetBranchAddress("pixIdX", &pixIdX);
+  tree->SetBranchAddress("pixIdY", &pixIdY);
+  tree->SetBranchAddress("eventId", &eventId);
+  tree->SetBranchAddress("runId", &runId);
+  tree->SetBranchAddress("geoCenterLocal", &geoCenterLocal);
+  tree->SetBranchAddress("geoCenterGlobal", &geoCenterGlobal);
+  tree->SetBranchAddress("parentTrackId", &parentTrackId);
+  tree->SetBranchAddress("trackId", &trackId);
+  tree->SetBranchAddress("pdgId", &pdgId);
+  bool hasPrimaryIdx = tree->GetBranch("primaryIdx") != nullptr;
+  if (hasPrimaryIdx) {
+    tree->SetBranchAddress("primaryIdx", &primaryIdx);
+  }
+  tree->SetBranchAddress("hitPosGlobal", &hitPosGlobal);
+  bool hasEntryPos = tree->GetBranch("hitEntryPosGlobal") != nullptr;
+  if (hasEntryPos) {
+    tree->SetBranchAddress("hitEntryPosGlobal", &hitEntryPosGlobal);
+  }
+  tree->SetBranchAddress("ipMomDir", &ipMomDir);
+  tree->SetBranchAddress("hitE", &hitE);
+  tree->SetBranchAddress("hitP", &hitP);
+  tree->SetBranchAddress("ipE", &ipE);
+  tree->SetBranchAddress("ipP", &ipP);
+  tree->SetBranchAddress("eDep", &eDep);
+  HitPrecisionReader precision(*tree);
+  bool hasWeights = tree->GetBranch("hitPrimaryWeight") != nullptr;
+  if (hasWeights) {
+    tree->SetBranchAddress("hitPrimaryWeight", &hitPrimaryWeight);
+  }
+
+  auto toG4 = [](const TVector3& v) {
+    return G4ThreeVector(v.X(), v.Y(), v.Z());
+  };
+  auto toG4Two = [](const TVector2& v) { return G4TwoVector(v.X(), v.Y()); };
+
+  // The pixels of an event are consecutive entries, the hits of
+  // its primaries are grouped when the event is complete
+  std::size_t eventBegin = 0;
+  auto splitEvent = [&]() {
+    auto begin = library.hits.begin() + eventBegin;
+    std::stable_sort(begin, library.hits.end(),
+                     [](const LibraryHit& a, const LibraryHit& b) {
+                       return a.primaryIdx < b.primaryIdx;
+                     });
+    for (auto it = begin; it != library.hits.end(); it++) {
+      if (it == begin || it->primaryIdx != (it - 1)->primaryIdx) {
+        library.eventBegin.push_back(it - library.hits.begin());
+      }
+    }
+    eventBegin = library.hits.size();
+  };
+
+  int lastRunId = -1;
+  int lastEventId = -1;
+  for (Long64_t entry = 0; entry < tree->GetEntries(); entry++) {
+    tree->GetEntry(entry);
+    if (runId != lastRunId || eventId != lastEventId) {
+      splitEvent();
+      lastRunId = runId;
+      lastEventId = eventId;
+    }
+    for (std::size_t i = 0; i < hitE->size(); i++) {
+      library.weighted |= hasWeights && hitPrimaryWeight->at(i) != 1;
+      library.hits.push_back(
+          {.geoId = geoId,
+           .pixIdX = pixIdX,
+           .pixIdY = pixIdY,
+           .parentTrackId = parentTrackId->at(i),
+           .trackId = trackId->at(i),
+           .pdgId = pdgId->at(i),
+           .primaryIdx = hasPrimaryIdx ? primaryIdx->at(i) : 0,
+           .pixCenterLocal = toG4Two(*geoCenterLocal),
+           .pixCenterGlobal = toG4(*geoCenterGlobal),
+           .hitPosGlobal = toG4(hitPosGlobal->at(i)),
+           .hitPosLocal =
+               toG4Two(precision.hitPosLocal(i, *geoCenterLocal)),
+           .hitEntryPosGlobal = hasEntryPos ? toG4(hitEntryPosGlobal->at(i))
+                                            : G4ThreeVector(),
+           .momDir = toG4(precision.hitMomDir(i)),
+           .eTot = hitE->at(i),
+           .pTot = hitP->at(i),
+           .momDirIP = toG4(ipMomDir->at(i)),
+           .eIP = ipE->at(i),
+           .pIP = ipP->at(i),
+           .vertex = toG4(precision.vertex(i)),
+           .eDep = eDep->at(i)});
+    }
+  }
+  splitEvent();
+  library.eventBegin.push_back(library.hits.size());
+  return true;
+}
+
+/// Library hits on the pixels of one frame that pass the threshold,
+/// with the position of their particle in the frame
+struct Frame {
+  std::vector<std::pair<std::size_t, std::uint32_t>> hits;
+
+  std::uint64_t particles = 0;
+  std::uint64_t pixels = 0;
+  std::uint64_t sharedPixels = 0;
+  std::uint64_t pixelsBelowThreshold = 0;
+};
+
+struct OverlayConfig {
+  /// Mean number of library particles that leave hits per frame
+  double meanWithHits;
+  double threshold;
+  std::uint64_t seed;
+};
+
+struct PixelSum {
+  double eDep = 0;
+  std::uint32_t lastSource = UINT32_MAX;
+  std::uint32_t nSources = 0;
+};
+
+void buildFrame(const Library& library, const OverlayConfig& cfg,
+                std::uint64_t frameIdx, Frame& frame) {
+  std::seed_seq seeds{static_cast<std::uint32_t>(cfg.seed),
+                      static_cast<std::uint32_t>(cfg.seed >> 32),
+                      static_cast<std::uint32_t>(frameIdx),
+                      static_cast<std::uint32_t>(frameIdx >> 32)};
+  std::mt19937_64 rng(seeds);
+  std::poisson_distribution<std::uint64_t> nParticles(cfg.meanWithHits);
+  std::uniform_int_distribution<std::size_t> event(0, library.nEvents() - 1);
+
+  frame = Frame();
+  frame.particles = cfg.meanWithHits > 0 ? nParticles(rng) : 0;
+
+  std::vector<std::size_t> sources(frame.particles);
+  for (auto& source : sources) {
+    source = event(rng);
+  }
+
+  auto pixelKey = [](const LibraryHit& hit) {
+    return (static_cast<std::uint64_t>(hit.geoId) << 32) |
+           (static_cast<std::uint64_t>(hit.pixIdX) << 16) |
+           static_cast<std::uint64_t>(hit.pixIdY);
+  };
+
+  std::unordered_map<std::uint64_t, PixelSum> pixels;
+  for (std::uint32_t s = 0; s < sources.size(); s++) {
+    for (std::size_t i = library.eventBegin[sources[s]];
+         i < library.eventBegin[sources[s] + 1]; i++) {
+      PixelSum& pixel = pixels[pixelKey(library.hits[i])];
+      pixel.eDep += library.hits[i].eDep;
+      if (pixel.lastSource != s) {
+        pixel.lastSource = s;
+        pixel.nSources++;
+      }
+    }
+  }
+
+  for (const auto& [key, pixel] : pixels) {
+    frame.sharedPixels += pixel.nSources > 1;
+    if (pixel.eDep / PixelGeometry::pairProductionE < cfg.threshold) {
+      frame.pixelsBelowThreshold++;
+    } else {
+      frame.pixels++;
+    }
+  }
+  for (std::uint32_t s = 0; s < sources.size(); s++) {
+    for (std::size_t i = library.eventBegin[sources[s]];
+         i < library.eventBegin[sources[s] + 1]; i++) {
+      if (pixels.at(pixelKey(library.hits[i])).eDep /
+              PixelGeometry::pairProductionE >=
+          cfg.threshold) {
+        frame.hits.emplace_back(i, s);
+      }
+    }
+  }
+}
+
+/// Builds frames [first, first + frames.size()) on nThreads threads
+void buildFrames(const Library& library, const OverlayConfig& cfg,
+                 std::uint64_t first, std::vector<Frame>& frames,
+                 int nThreads) {
+  std::atomic<std::size_t> next{0};
+  std::vector<std::thread> workers;
+  for (int t = 0; t < nThreads; t++) {
+    workers.emplace_back([&]() {
+      for (std::size_t i = next++; i < frames.size(); i = next++) {
+        buildFrame(library, cfg, first + i, frames[i]);
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+struct OverlayStats {
+  std::uint64_t particles = 0;
+  std::uint64_t pixels = 0;
+  std::uint64_t sharedPixels = 0;
+  std::uint64_t pixelsBelowThreshold = 0;
+};
+
+void recordFrame(const Library& library, const Frame& frame,
+                 std::uint64_t frameIdx, Run& run, OverlayStats& stats) {
+  stats.particles += frame.particles;
+  stats.pixels += frame.pixels;
+  stats.sharedPixels += frame.sharedPixels;
+  stats.pixelsBelowThreshold += frame.pixelsBelowThreshold;
+
+  auto hitsCollection =
+      new TrackerHitsCollection("OverlayHits", "HitsCollection");
+  for (const auto& [i, source] : frame.hits) {
+    const LibraryHit& libraryHit = library.hits[i];
+    auto hit = new SamplingHit();
+    hit->SetGeometryId(libraryHit.geoId);
+    hit->SetPixelId(libraryHit.pixIdX, libraryHit.pixIdY);
+    hit->SetParentTrackId(libraryHit.parentTrackId);
+    // Renumbered like the primaries of a batched event, which keeps
+    // isSignal; the secondaries are told apart by primaryIdx
+    hit->SetTrackId(libraryHit.parentTrackId == 0 ? source + 1
+                                                  : libraryHit.trackId);
+    hit->SetPdgId(libraryHit.pdgId);
+    hit->SetPrimaryIdx(source);
+    hit->SetPixCenterLocal(libraryHit.pixCenterLocal);
+    hit->SetPixCenterGlobal(libraryHit.pixCenterGlobal);
+    hit->SetHitPosGlobal(libraryHit.hitPosGlobal);
+    hit->SetHitPosLocal(libraryHit.hitPosLocal);
+    hit->SetHitEntryPosGlobal(libraryHit.hitEntryPosGlobal);
+    hit->SetMomDir(libraryHit.momDir);
+    hit->SetETot(libraryHit.eTot);
+    hit->SetPTot(libraryHit.pTot);
+    hit->SetMomDirIP(libraryHit.momDirIP);
+    hit->SetEIP(libraryHit.eIP);
+    hit->SetPIP(libraryHit.pIP);
+    hit->SetVertex(libraryHit.vertex);
+    hit->SetEDep(libraryHit.eDep);
+    hitsCollection->insert(hit);
+  }
+
+  G4Event event(static_cast<int>(frameIdx));
+  auto hce = new G4HCofThisEvent(1);
+  hce->AddHitsCollection(0, hitsCollection);
+  event.SetHCofThisEvent(hce);
+  run.RecordEvent(&event);
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 5) {
+    std::printf(
+        "Usage: %s <library.root> <output.root> <mean> <nFrames> "
+        "[threshold[e]] [nThreads] [seed] [treeName]\n",
+        argv[0]);
+    return 1;
+  }
+  std::string inputPath = argv[1];
+  std::string outputPath = argv[2];
+  double mean = std::stod(argv[3]);
+  std::uint64_t nFrames = std::stoull(argv[4]);
+  double threshold = argc > 5 ? std::stod(argv[5]) : 0;
+  int nThreads = argc > 6 ? std::stoi(argv[6])
+                          : std::max(1u, std::thread::hardware_concurrency());
+  std::uint64_t seed = argc > 7 ? std::stoull(argv[7]) : 1;
+  std::string treeName = argc > 8 ? argv[8] : "particles";
+  const std::size_t chunkSize = 4096;
+
+  TFile input(inputPath.c_str(), "READ");
+  auto* libraryTree = input.Get<TTree>(treeName.c_str());
+  if (libraryTree != nullptr &&
+      libraryTree->GetBranch("pixelHitOffset") != nullptr) {
+    std::fprintf(stderr,
+                 "%s has the event layout, simulate the library with "
+                 "--output=root\n",
+                 inputPath.c_str());
+    return 1;
+  }
+  Library library;
+  if (!readLibrary(input, treeName, library) || library.nEvents() == 0) {
+    std::fprintf(stderr, "%s has no %s tree with hits\n", inputPath.c_str(),
+                 treeName.c_str());
+    return 1;
+  }
+  // The particles are drawn unweighted, so must be the library
+  if (readParameter(input, "acceptanceRejectedSimulated", 0) > 0 ||
+      readParameter(input, "generatorEnergyProposal", 0) != 0 ||
+      readParameter(input, "generatorAngleProposalScale", 1) != 1 ||
+      library.weighted) {
+    std::fprintf(stderr,
+                 "%s holds weighted events, simulate the library without "
+                 "--acceptance-keep, --energy-proposal and "
+                 "--angle-proposal-scale\n",
+                 inputPath.c_str());
+    return 1;
+  }
+  // Skipped primaries count as simulated particles without hits
+  double simulatedEvents = readParameter(
+      input, "acceptanceGenerated",
+      readParameter(input, "numberOfEvents", 0) *
+          readParameter(input, "primariesPerEvent", 1));
+  if (simulatedEvents < library.nEvents()) {
+    std::fprintf(stderr,
+                 "%s does not record the simulated events, assuming that "
+                 "every particle leaves hits\n",
+                 inputPath.c_str());
+    simulatedEvents = library.nEvents();
+  }
+
+  OverlayConfig cfg{.meanWithHits = mean * library.nEvents() / simulatedEvents,
+                    .threshold = threshold,
+                    .seed = seed};
+  std::printf(
+      "Library: %zu particles with hits of %.0f simulated, %zu hits; %.3f "
+      "particles with hits per frame\n",
+      library.nEvents(), simulatedEvents, library.hits.size(),
+      cfg.meanWithHits);
+
+  auto start = std::chrono::steady_clock::now();
+  OverlayStats stats;
+  {
+    Run run(outputPath, treeName, threshold);
+    run.SetRunID(0);
+
+    // The next chunk is mixed while the current one is written
+    std::vector<Frame> current(std::min<std::uint64_t>(chunkSize, nFrames));
+    std::vector<Frame> next;
+    buildFrames(library, cfg, 0, current, nThreads);
+    for (std::uint64_t first = 0; first < nFrames; first += current.size()) {
+      std::uint64_t nextFirst = first + current.size();
+      next.resize(std::min<std::uint64_t>(chunkSize, nFrames - nextFirst));
+      std::thread mixer(buildFrames, std::cref(library), std::cref(cfg),
+                        nextFirst, std::ref(next), nThreads);
+      for (std::size_t i = 0; i < current.size(); i++) {
+        recordFrame(library, current[i], first + i, run, stats);
+      }
+      mixer.join();
+      std::swap(current, next);
+      if (current.empty()) {
+        break;
+      }
+    }
+
+    run.addMetadata("overlayMean", mean);
+    run.addMetadata("overlayMeanWithHits", cfg.meanWithHits);
+    run.addMetadata("overlayThreshold", threshold);
+    run.addMetadata("overlayLibraryEvents", library.nEvents());
+    run.addMetadata("overlayLibrarySimulatedEvents", simulatedEvents);
+    run.addMetadata("overlayParticlesWithHits", stats.particles);
+    run.addMetadata("overlaySharedPixels", stats.sharedPixels);
+    run.addMetadata("overlayPixelsBelowThreshold", stats.pixelsBelowThreshold);
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::printf(
+      "Mixed %llu frames in %.2f s (%.0f frames/s) on %d threads: %llu "
+      "particles with hits, %llu pixels, %llu shared, %llu below "
+      "threshold\n",
+      static_cast<unsigned long long>(nFrames), seconds, nFrames / seconds,
+      nThreads, static_cast<unsigned long long>(stats.particles),
+      static_cast<unsigned long long>(stats.pixels),
+      static_cast<unsigned long long>(stats.sharedPixels),
+      static_cast<unsigned long long>(stats.pixelsBelowThreshold));
+  return 0;
+}
@@ -0,0 +1,508 @@
+// Reprocesses the simulated hits for a new set of chip alignments
+// without re-running the simulation. The sensors are thin, so every
+// hit is moved along its straight entry-exit segment to the exit
+// plane of the realigned sensor, and the pixel is recomputed with
+// the maths of SamplingVolume::ProcessHits. Hits that miss the moved
+// chip are dropped; particles that only the moved chip would see
+// cannot be recovered.
+//
+// Usage: alWindowRealign <input.root> <output.root> <alignment.txt>
+//                        [treeName] [alongSlitTranslation[mm]]
+//                        [verticalStagger[mm]]
+//
+// alignment.txt holds "geoId dx[mm] dy[mm] rotation[deg]" per line,
+// # starts a comment. The listed chips replace the nominal alignment.
+//
+// The event weights and the primaries of the hits are carried over,
+// as is the metadata of the input with its numberOfEvents. Phase
+// space replays are refused: the stage one track ids that decide
+// isSignal are not in the output.
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include "DetectorConstruction.hh"
+#include "EventInformation.hh"
+#include "G4Event.hh"
+#include "G4HCofThisEvent.hh"
+#include "G4RotationMatrix.hh"
+#include "G4SystemOfUnits.hh"
+#include "G4ThreeVector.hh"
+#include "G4VPhysicalVolume.hh"
+#include "GeometryConstants.hh"
+#include "HitPrecisionReader.hh"
+#include "PixelGeometry.hh"
+#include "PlacementWalker.hh"
+#include "Run.hh"
+#include "SamplingHit.hh"
+#include "TFile.h"
+#include "TKey.h"
+#include "TList.h"
+#include "TParameter.h"
+#include "TTree.h"
+#include "TVector3.h"
+
+namespace {
+
+using Alignment = std::unordered_map<int, std::tuple<double, double, double>>;
+
+/// Sensitive volume frame in the touchable convention,
+/// local = rotation^-1 (global - origin)
+struct SensorFrame {
+  G4ThreeVector originVector;
+  G4RotationMatrix rotationMatrix;
+
+  // The same in plain arrays for the batch loops
+  double origin[3];
+  double rotation[3][3];
+  double inverse[3][3];
+};
+
+SensorFrame makeFrame(const G4ThreeVector& origin,
+                      const G4RotationMatrix& rotation) {
+  SensorFrame frame{origin, rotation};
+  G4RotationMatrix inverse = rotation.inverse();
+  for (int i = 0; i < 3; i++) {
+    frame.origin[i] = origin[i];
+    for (int j = 0; j < 3; j++) {
+      frame.rotation[i][j] = rotation(i, j);
+      frame.inverse[i][j] = inverse(i, j);
+    }
+  }
+  return frame;
+}
+
+std::map<int, SensorFrame> buildSensorFrames(double alongSlitTranslation,
+                                             double verticalStagger,
+                                             const Alignment& alignment) {
+  const GeometryConstants& gc = *GeometryConstants::instance();
+  DetectorConstruction detector(alongSlitTranslation, verticalStagger);
+  for (const auto& [id, pars] : alignment) {
+    if (id / 10 == gc.tc1GeoIdPrefix / 10) {
+      detector.tc1ChipAlignmentPars[id] = pars;
+    } else if (id / 10 == gc.tc2GeoIdPrefix / 10) {
+      detector.tc2ChipAlignmentPars[id] = pars;
+    }
+  }
+
+  std::map<int, SensorFrame> frames;
+  const std::string prefix = "OPPPSensitive";
+  walkPlacements(detector.Construct(),
+                 [&](const G4VPhysicalVolume* volume,
+                     const G4RotationMatrix& rotation,
+                     const G4ThreeVector& translation) {
+                   const std::string& name = volume->GetName();
+                   if (name.rfind(prefix, 0) != 0) {
+                     return true;
+                   }
+                   // The touchable returns the inverse, frame rotation
+                   frames[std::stoi(name.substr(prefix.size()))] =
+                       makeFrame(translation, rotation.inverse());
+                   return false;
+                 });
+  return frames;
+}
+
+Alignment readAlignment(const std::string& path) {
+  Alignment alignment;
+  std::ifstream file(path);
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream stream(line);
+    int id;
+    double dx, dy, rotation;
+    if (stream >> id >> dx >> dy >> rotation) {
+      alignment[id] = {dx * mm, dy * mm, rotation * deg};
+    }
+  }
+  return alignment;
+}
+
+/// Hits of several events in structure of arrays layout
+struct HitBatch {
+  std::vector<SamplingHit*> hits;
+  std::vector<int> frame;
+
+  std::vector<double> entryX, entryY, entryZ;
+  std::vector<double> exitX, exitY, exitZ;
+
+  // Realigned local and global exit points
+  std::vector<double> localX, localY, localZ;
+  std::vector<double> globalX, globalY, globalZ;
+
+  /// (runId, eventId, end of the event in hits)
+  std::vector<std::tuple<int, int, std::size_t>> events;
+  /// Weight and primaries of the events, handed to their G4Event
+  std::vector<std::unique_ptr<EventInformation>> information;
+
+  void add(SamplingHit* hit, int frameIdx) {
+    hits.push_back(hit);
+    frame.push_back(frameIdx);
+    G4ThreeVector entry = hit->GetHitEntryPosGlobal();
+    G4ThreeVector exit = hit->GetHitPosGlobal();
+    entryX.push_back(entry.x());
+    entryY.push_back(entry.y());
+    entryZ.push_back(entry.z());
+    exitX.push_back(exit.x());
+    exitY.push_back(exit.y());
+    exitZ.push_back(exit.z());
+  }
+
+  void clear() { *this = HitBatch(); }
+};
+
+/// Moves the exit points to the exit plane of the realigned sensors
+void realign(HitBatch& batch, const std::vector<SensorFrame>& nominal,
+             const std::vector<SensorFrame>& aligned) {
+  std::size_t n = batch.hits.size();
+  batch.localX.resize(n);
+  batch.localY.resize(n);
+  batch.localZ.resize(n);
+  batch.globalX.resize(n);
+  batch.globalY.resize(n);
+  batch.globalZ.resize(n);
+
+  for (std::size_t i = 0; i < n; i++) {
+    const SensorFrame& from = nominal[batch.frame[i]];
+    const SensorFrame& to = aligned[batch.frame[i]];
+
+    // Depth of the exit point in the nominal sensor
+    double ex = batch.exitX[i] - from.origin[0];
+    double ey = batch.exitY[i] - from.origin[1];
+    double ez = batch.exitZ[i] - from.origin[2];
+    double exitDepth = from.inverse[2][0] * ex + from.inverse[2][1] * ey +
+                       from.inverse[2][2] * ez;
+
+    // Entry and exit points in the realigned sensor
+    double ax = batch.entryX[i] - to.origin[0];
+    double ay = batch.entryY[i] - to.origin[1];
+    double az = batch.entryZ[i] - to.origin[2];
+    double bx = batch.exitX[i] - to.origin[0];
+    double by = batch.exitY[i] - to.origin[1];
+    double bz = batch.exitZ[i] - to.origin[2];
+    double entryLocal[3], exitLocal[3];
+    for (int k = 0; k < 3; k++) {
+      entryLocal[k] = to.inverse[k][0] * ax + to.inverse[k][1] * ay +
+                      to.inverse[k][2] * az;
+      exitLocal[k] = to.inverse[k][0] * bx + to.inverse[k][1] * by +
+                     to.inverse[k][2] * bz;
+    }
+
+    // Segments parallel to the sensor keep their exit point
+    double dz = exitLocal[2] - entryLocal[2];
+    double t = std::abs(dz) > 1e-9 * mm ? (exitDepth - entryLocal[2]) / dz : 1;
+    double local[3];
+    for (int k = 0; k < 3; k++) {
+      local[k] = entryLocal[k] + t * (exitLocal[k] - entryLocal[k]);
+    }
+    batch.localX[i] = local[0];
+    batch.localY[i] = local[1];
+    batch.localZ[i] = local[2];
+
+    batch.globalX[i] = to.rotation[0][0] * local[0] +
+                       to.rotation[0][1] * local[1] +
+                       to.rotation[0][2] * local[2] + to.origin[0];
+    batch.globalY[i] = to.rotation[1][0] * local[0] +
+                       to.rotation[1][1] * local[1] +
+                       to.rotation[1][2] * local[2] + to.origin[1];
+    batch.globalZ[i] = to.rotation[2][0] * local[0] +
+                       to.rotation[2][1] * local[1] +
+                       to.rotation[2][2] * local[2] + to.origin[2];
+  }
+}
+
+struct RealignStats {
+  std::uint64_t hits = 0;
+  std::uint64_t dropped = 0;
+  std::uint64_t movedPixel = 0;
+};
+
+/// Updates the hits and records them event by event
+void recordBatch(HitBatch& batch, const std::vector<SensorFrame>& aligned,
+                 Run& run, RealignStats& stats) {
+  std::size_t begin = 0;
+  for (std::size_t e = 0; e < batch.events.size(); e++) {
+    const auto& [runId, eventId, end] = batch.events[e];
+    auto hitsCollection =
+        new TrackerHitsCollection("RealignedHits", "HitsCollection");
+
+    for (std::size_t i = begin; i < end; i++) {
+      SamplingHit* hit = batch.hits[i];
+      stats.hits++;
+      if (std::abs(batch.localX[i]) >= PixelGeometry::chipX / 2.0 ||
+          std::abs(batch.localY[i]) >= PixelGeometry::chipY / 2.0) {
+        stats.dropped++;
+        delete hit;
+        continue;
+      }
+
+      const SensorFrame& frame = aligned[batch.frame[i]];
+
+      int pixIdX = PixelGeometry::pixelIdX(batch.localX[i]);
+      int pixIdY = PixelGeometry::pixelIdY(batch.localY[i]);
+      if (hit->GetPixelId() != std::pair{pixIdX, pixIdY}) {
+        stats.movedPixel++;
+      }
+      G4TwoVector pixCenterLocal = PixelGeometry::pixelCenter(pixIdX, pixIdY);
+
+      hit->SetHitPosGlobal(
+          {batch.globalX[i], batch.globalY[i], batch.globalZ[i]});
+      hit->SetHitPosLocal({batch.localX[i], batch.localY[i]});
+      hit->SetPixelId(pixIdX, pixIdY);
+      hit->SetPixCenterLocal(pixCenterLocal);
+      hit->SetPixCenterGlobal(
+          PixelGeometry::toGlobal(pixCenterLocal, frame.originVector,
+                                  frame.rotationMatrix));
+      hitsCollection->insert(hit);
+    }
+    begin = end;
+
+    G4Event event(eventId);
+    event.SetUserInformation(batch.information[e].release());
+    auto hce = new G4HCofThisEvent(1);
+    hce->AddHitsCollection(0, hitsCollection);
+    event.SetHCofThisEvent(hce);
+    run.SetRunID(runId);
+    run.RecordEvent(&event);
+  }
+  batch.clear();
+}
+
+/// The TParameter<double> metadata of the file
+std::vector<std::pair<std::string, double>> readMetadata(TFile& file) {
+  std::vector<std::pair<std::string, double>> metadata;
+  for (auto* object : *file.GetListOfKeys()) {
+    auto* key = static_cast<TKey*>(object);
+    if (std::string(key->GetClassName()) != "TParameter<double>") {
+      continue;
+    }
+    std::unique_ptr<TParameter<double>> parameter(
+        key->ReadObject<TParameter<double>>());
+    metadata.emplace_back(key->GetName(), parameter->GetVal());
+  }
+  return metadata;
+}
+
+double findMetadata(
+    const std::vector<std::pair<std::string, double>>& metadata,
+    const std::string& name, double fallback) {
+  for (const auto& [key, value] : metadata) {
+    if (key == name) {
+      return value;
+    }
+  }
+  return fallback;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::printf(
+        "Usage: %s <input.root> <output.root> <alignment.txt> [treeName] "
+        "[alongSlitTranslation[mm]] [verticalStagger[mm]]\n",
+        argv[0]);
+    return 1;
+  }
+  std::string inputPath = argv[1];
+  std::string outputPath = argv[2];
+  Alignment alignment = readAlignment(argv[3]);
+  std::string treeName = argc > 4 ? argv[4] : "particles";
+  double alongSlitTranslation = argc > 5 ? std::stod(argv[5]) * mm : 0;
+  double verticalStagger = argc > 6 ? std::stod(argv[6]) * mm : 0;
+  const std::size_t batchSize = 1 << 16;
+
+  // Sensor frames of the simulated and of the new geometry
+  auto nominalFrames =
+      buildSensorFrames(alongSlitTranslation, verticalStagger, {});
+  auto alignedFrames =
+      buildSensorFrames(alongSlitTranslation, verticalStagger, alignment);
+
+  std::unordered_map<int, int> frameIdx;
+  std::vector<SensorFrame> nominal, aligned;
+  for (const auto& [id, frame] : nominalFrames) {
+    frameIdx[id] = nominal.size();
+    nominal.push_back(frame);
+    aligned.push_back(alignedFrames.at(id));
+  }
+
+  TFile input(inputPath.c_str(), "READ");
+  auto* tree = input.Get<TTree>(treeName.c_str());
+  if (tree != nullptr && tree->GetBranch("pixelHitOffset") != nullptr) {
+    std::fprintf(stderr,
+                 "%s has the event layout, simulate with --output=root\n",
+                 inputPath.c_str());
+    return 1;
+  }
+  if (tree == nullptr || tree->GetBranch("hitEntryPosGlobal") == nullptr) {
+    std::fprintf(stderr, "%s has no %s tree with the hit entry points\n",
+                 inputPath.c_str(), treeName.c_str());
+    return 1;
+  }
+  auto metadata = readMetadata(input);
+  if (findMetadata(metadata, "phaseSpaceReplay", 0) != 0) {
+    std::fprintf(stderr,
+                 "%s is a phase space replay, its isSignal cannot be "
+                 "recomputed without the stage one track ids\n",
+                 inputPath.c_str());
+    return 1;
+  }
+  // The weighting pre-filter is the only source of weights when it
+  // ran, its primaries outside the acceptance weigh 1/keepFraction.
+  // With a keepFraction of 1 they are counted as inside
+  bool acceptanceWeights =
+      findMetadata(metadata, "acceptanceRejectedSimulated", 0) > 0;
+
+  int geoId, eventId, runId;
+  double eventWeight = 1;
+  std::vector<int>* parentTrackId = nullptr;
+  std::vector<int>* trackId = nullptr;
+  std::vector<int>* primaryIdx = nullptr;
+  std::vector<int>* pdgId = nullptr;
+  std::vector<TVector3>* hitPosGlobal = nullptr;
+  std::vector<TVector3>* hitEntryPosGlobal = nullptr;
+  std::vector<TVector3>* ipMomDir = nullptr;
+  std::vector<double>* hitE = nullptr;
+  std::vector<double>* hitP = nullptr;
+  std::vector<double>* ipE = nullptr;
+  std::vector<double>* ipP = nullptr;
+  std::vector<double>* eDep = nullptr;
+  std::vector<double>* hitPrimaryE = nullptr;
+  std::vector<double>* hitPrimaryTheta = nullptr;
+  std::vector<double>* hitPrimaryPhi = nullptr;
+  std::vector<double>* hitPrimaryWeight = nullptr;
+  tree->SetBranchAddress("geoId", &geoId);
+  tree->SetBranchAddress("eventId", &eventId);
+  tree->SetBranchAddress("runId", &runId);
+  tree->SetBranchAddress("parentTrackId", &parentTrackId);
+  tree->SetBranchAddress("trackId", &trackId);
+  bool hasPrimaryIdx = tree->GetBranch("primaryIdx") != nullptr;
+  if (hasPrimaryIdx) {
+    tree->SetBranchAddress("primaryIdx", &primaryIdx);
+  }
+  tree->SetBranchAddress("pdgId", &pdgId);
+  tree->SetBranchAddress("hitPosGlobal", &hitPosGlobal);
+  tree->SetBranchAddress("hitEntryPosGlobal", &hitEntryPosGlobal);
+  tree->SetBranchAddress("ipMomDir", &ipMomDir);
+  tree->SetBranchAddress("hitE", &hitE);
+  tree->SetBranchAddress("hitP", &hitP);
+  tree->SetBranchAddress("ipE", &ipE);
+  tree->SetBranchAddress("ipP", &ipP);
+  tree->SetBranchAddress("eDep", &eDep);
+  if (tree->GetBranch("eventWeight") != nullptr) {
+    tree->SetBranchAddress("eventWeight", &eventWeight);
+  }
+  bool hasPrimaries =
+      hasPrimaryIdx && tree->GetBranch("hitPrimaryWeight") != nullptr;
+  if (hasPrimaries) {
+    tree->SetBranchAddress("hitPrimaryE", &hitPrimaryE);
+    tree->SetBranchAddress("hitPrimaryTheta", &hitPrimaryTheta);
+    tree->SetBranchAddress("hitPrimaryPhi", &hitPrimaryPhi);
+    tree->SetBranchAddress("hitPrimaryWeight", &hitPrimaryWeight);
+  }
+  HitPrecisionReader precision(*tree);
+
+  auto toG4 = [](const TVector3& v) {
+    return G4ThreeVector(v.X(), v.Y(), v.Z());
+  };
+
+  auto start = std::chrono::steady_clock::now();
+  RealignStats stats;
+  std::uint64_t unknownSensor = 0;
+  {
+    Run run(outputPath, treeName, 0);
+    // Run recounts the weighted events with hits of the realigned hits
+    for (const auto& [name, value] : metadata) {
+      if (name.rfind("weightedEventsWithHits", 0) != 0) {
+        run.addMetadata(name, value);
+      }
+    }
+    HitBatch batch;
+    for (Long64_t entry = 0; entry < tree->GetEntries(); entry++) {
+      tree->GetEntry(entry);
+
+      // The pixels of an event are consecutive entries
+      bool newEvent = batch.events.empty() ||
+                      std::get<0>(batch.events.back()) != runId ||
+                      std::get<1>(batch.events.back()) != eventId;
+      if (newEvent && batch.hits.size() >= batchSize) {
+        realign(batch, nominal, aligned);
+        recordBatch(batch, aligned, run, stats);
+      }
+      if (newEvent) {
+        batch.events.emplace_back(runId, eventId, batch.hits.size());
+        auto information = std::make_unique<EventInformation>();
+        information->weight = eventWeight;
+        information->outsideAcceptance = acceptanceWeights && eventWeight != 1;
+        batch.information.push_back(std::move(information));
+      }
+
+      auto it = frameIdx.find(geoId);
+      if (it == frameIdx.end()) {
+        unknownSensor += hitE->size();
+        continue;
+      }
+      for (std::size_t i = 0; i < hitE->size(); i++) {
+        auto hit = new SamplingHit();
+        hit->SetGeometryId(geoId);
+        hit->SetParentTrackId(parentTrackId->at(i));
+        hit->SetTrackId(trackId->at(i));
+        hit->SetPrimaryIdx(hasPrimaryIdx ? primaryIdx->at(i) : 0);
+        hit->SetPdgId(pdgId->at(i));
+        hit->SetHitPosGlobal(toG4(hitPosGlobal->at(i)));
+        hit->SetHitEntryPosGlobal(toG4(hitEntryPosGlobal->at(i)));
+        hit->SetMomDir(toG4(precision.hitMomDir(i)));
+        hit->SetMomDirIP(toG4(ipMomDir->at(i)));
+        hit->SetVertex(toG4(precision.vertex(i)));
+        hit->SetEDep(eDep->at(i));
+        hit->SetETot(hitE->at(i));
+        hit->SetPTot(hitP->at(i));
+        hit->SetEIP(ipE->at(i));
+        hit->SetPIP(ipP->at(i));
+        batch.add(hit, it->second);
+
+        // The primaries without hits keep the placeholders, Run reads
+        // only those of the hits
+        int idx = hit->GetPrimaryIdx();
+        if (hasPrimaries && idx >= 0) {
+          EventInformation& information = *batch.information.back();
+          if (static_cast<int>(information.primaryE.size()) <= idx) {
+            information.primaryE.resize(idx + 1, 0);
+            information.primaryTheta.resize(idx + 1, 0);
+            information.primaryPhi.resize(idx + 1, 0);
+            information.primaryWeight.resize(idx + 1, 1);
+          }
+          information.primaryE[idx] = hitPrimaryE->at(i);
+          information.primaryTheta[idx] = hitPrimaryTheta->at(i);
+          information.primaryPhi[idx] = hitPrimaryPhi->at(i);
+          information.primaryWeight[idx] = hitPrimaryWeight->at(i);
+        }
+      }
+      std::get<2>(batch.events.back()) = batch.hits.size();
+    }
+    realign(batch, nominal, aligned);
+    recordBatch(batch, aligned, run, stats);
+  }
+  double seconds = std::chrono::duration<double>(
+                       std::chrono::steady_clock::now() - start)
+                       .count();
+
+  std::printf(
+      "Realigned %llu hits in %.2f s (%.0f hits/s): %llu moved to another "
+      "pixel, %llu off the chip, %llu on unknown sensors\n",
+      static_cast<unsigned long long>(stats.hits), seconds,
+      stats.hits / seconds, static_cast<unsigned long long>(stats.movedPixel),
+      static_cast<unsigned long long>(stats.dropped),
+      static_cast<unsigned long long>(unknownSensor));
+  return 0;
+}
@@ -0,0 +1,242 @@
+// Reweights a library simulated with the beam generator (--beam) to
+// a new target spectrum without re-simulating it. The weight of a hit
+// is target over proposal density of its own primary, from the
+// hitPrimaryE/Theta/Phi branches; the other primaries of the event do
+// not enter. The proposal is read from the generator metadata of the
+// library. The weights go to a friend tree with one entry per
+// library entry and one weight per hit:
+//
+//   tree->AddFriend("<treeName>Weights", "<output.root>");
+//   tree->Draw("hitE", "<treeName>Weights.hitTargetWeight");
+//
+// The pixel layout holds only the primaries with hits, so event level
+// weights, the product over all primaries, cannot be recomputed.
+//
+// The target energy spectrum holds "E[GeV] density" per line, #
+// starts a comment. It is interpolated linearly and normalised, so
+// "-" keeps the nominal flat spectrum. The target angles are
+// Gaussian with the given sigmas, by default the nominal ones.
+//
+// Usage: alWindowReweight <library.root> <output.root> <spectrum.txt|->
+//                         [sigmaTheta[rad]] [sigmaPhi[rad]] [treeName]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "G4SystemOfUnits.hh"
+#include "PrimarySampler.hh"
+#include "TFile.h"
+#include "TParameter.h"
+#include "TTree.h"
+
+namespace {
+
+/// Piecewise linear density, zero outside the tabulated energies
+class Spectrum {
+ public:
+  explicit Spectrum(const std::string& path) {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+      line = line.substr(0, line.find('#'));
+      std::istringstream stream(line);
+      double energy, density;
+      if (stream >> energy >> density) {
+        m_points.emplace_back(energy * GeV, density);
+      }
+    }
+    std::sort(m_points.begin(), m_points.end());
+
+    double integral = 0;
+    for (std::size_t i = 1; i < m_points.size(); i++) {
+      integral += 0.5 * (m_points[i].second + m_points[i - 1].second) *
+                  (m_points[i].first - m_points[i - 1].first);
+    }
+    for (auto& [energy, density] : m_points) {
+      density /= integral;
+    }
+  }
+
+  bool valid() const {
+    return m_points.size() >= 2 && std::isfinite(m_points[0].second);
+  }
+
+  double operator()(double energy) const {
+    auto upper = std::upper_bound(
+        m_points.begin(), m_points.end(), energy,
+        [](double e, const std::pair<double, double>& p) {
+          return e < p.first;
+        });
+    if (upper == m_points.begin() || upper == m_points.end()) {
+      return 0;
+    }
+    auto lower = upper - 1;
+    double t = (energy - lower->first) / (upper->first - lower->first);
+    return lower->second + t * (upper->second - lower->second);
+  }
+
+  /// Probability of the target outside [energyMin, energyMax]
+  double outside(double energyMin, double energyMax) const {
+    const int nSteps = 100000;
+    double first = m_points.front().first;
+    double step = (m_points.back().first - first) / nSteps;
+    double probability = 0;
+    for (int i = 0; i < nSteps; i++) {
+      double energy = first + (i + 0.5) * step;
+      if (energy < energyMin || energy > energyMax) {
+        probability += (*this)(energy) * step;
+      }
+    }
+    return probability;
+  }
+
+ private:
+  std::vector<std::pair<double, double>> m_points;
+};
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 4) {
+    std::printf(
+        "Usage: %s <library.root> <output.root> <spectrum.txt|-> "
+        "[sigmaTheta[rad]] [sigmaPhi[rad]] [treeName]\n",
+        argv[0]);
+    return 1;
+  }
+  std::string inputPath = argv[1];
+  std::string outputPath = argv[2];
+  std::string spectrumPath = argv[3];
+  std::string treeName = argc > 6 ? argv[6] : "particles";
+
+  TFile input(inputPath.c_str(), "READ");
+  auto parameter = [&](const char* name) -> const TParameter<double>* {
+    return input.Get<TParameter<double>>(name);
+  };
+  for (const char* name :
+       {"generatorEnergyMin", "generatorEnergyMax", "generatorSigmaTheta",
+        "generatorSigmaPhi", "generatorEnergyProposal",
+        "generatorAngleProposalScale"}) {
+    if (parameter(name) == nullptr) {
+      std::fprintf(stderr, "%s has no %s, simulate the library with --beam\n",
+                   inputPath.c_str(), name);
+      return 1;
+    }
+  }
+  PrimarySampler proposal(
+      {.energyMin = parameter("generatorEnergyMin")->GetVal(),
+       .energyMax = parameter("generatorEnergyMax")->GetVal(),
+       .sigmaTheta = parameter("generatorSigmaTheta")->GetVal(),
+       .sigmaPhi = parameter("generatorSigmaPhi")->GetVal(),
+       .energyProposal = static_cast<PrimarySampler::EnergyProposal>(
+           parameter("generatorEnergyProposal")->GetVal()),
+       .angleProposalScale =
+           parameter("generatorAngleProposalScale")->GetVal()});
+  const PrimarySampler::Config& cfg = proposal.config();
+  double sigmaTheta = argc > 4 ? std::stod(argv[4]) : cfg.sigmaTheta;
+  double sigmaPhi = argc > 5 ? std::stod(argv[5]) : cfg.sigmaPhi;
+
+  bool nominalSpectrum = spectrumPath == "-";
+  Spectrum spectrum(nominalSpectrum ? "" : spectrumPath);
+  if (!nominalSpectrum) {
+    if (!spectrum.valid()) {
+      std::fprintf(stderr, "%s holds no normalisable spectrum\n",
+                   spectrumPath.c_str());
+      return 1;
+    }
+    double outside = spectrum.outside(cfg.energyMin, cfg.energyMax);
+    if (outside > 1e-6) {
+      std::fprintf(stderr,
+                   "%.3g of the target spectrum lies outside the simulated "
+                   "[%g, %g] GeV and cannot be recovered\n",
+                   outside, cfg.energyMin / GeV, cfg.energyMax / GeV);
+    }
+  }
+  // The nominal beam of the generator with the target angles
+  PrimarySampler target({.energyMin = cfg.energyMin,
+                         .energyMax = cfg.energyMax,
+                         .sigmaTheta = sigmaTheta,
+                         .sigmaPhi = sigmaPhi});
+  auto targetDensity = [&](double energy, double theta, double phi) {
+    double energyDensity = nominalSpectrum
+                               ? target.nominalEnergyDensity(energy)
+                               : spectrum(energy);
+    return energyDensity * target.nominalAngleDensity(theta, phi);
+  };
+
+  auto* tree = input.Get<TTree>(treeName.c_str());
+  if (tree == nullptr || tree->GetBranch("hitPrimaryE") == nullptr) {
+    std::fprintf(stderr,
+                 "%s has no %s tree with the primaries of the hits, "
+                 "reweight the pixel layout\n",
+                 inputPath.c_str(), treeName.c_str());
+    return 1;
+  }
+  int eventId, runId;
+  std::vector<int>* primaryIdx = nullptr;
+  std::vector<double>* hitPrimaryE = nullptr;
+  std::vector<double>* hitPrimaryTheta = nullptr;
+  std::vector<double>* hitPrimaryPhi = nullptr;
+  tree->SetBranchAddress("eventId", &eventId);
+  tree->SetBranchAddress("runId", &runId);
+  tree->SetBranchAddress("primaryIdx", &primaryIdx);
+  tree->SetBranchAddress("hitPrimaryE", &hitPrimaryE);
+  tree->SetBranchAddress("hitPrimaryTheta", &hitPrimaryTheta);
+  tree->SetBranchAddress("hitPrimaryPhi", &hitPrimaryPhi);
+
+  TFile output(outputPath.c_str(), "RECREATE");
+  std::string weightsName = treeName + "Weights";
+  TTree weights(weightsName.c_str(), weightsName.c_str());
+  std::vector<double> hitTargetWeight;
+  weights.Branch("hitTargetWeight", &hitTargetWeight);
+
+  // The pixels of an event are consecutive entries; every primary
+  // with hits counts once for the effective sample size
+  int lastRunId = -1;
+  int lastEventId = -1;
+  std::set<int> eventPrimaries;
+  std::uint64_t nPrimaries = 0;
+  double sumWeights = 0, sumWeights2 = 0;
+  for (Long64_t entry = 0; entry < tree->GetEntries(); entry++) {
+    tree->GetEntry(entry);
+    if (runId != lastRunId || eventId != lastEventId) {
+      lastRunId = runId;
+      lastEventId = eventId;
+      eventPrimaries.clear();
+    }
+
+    hitTargetWeight.resize(hitPrimaryE->size());
+    for (std::size_t i = 0; i < hitPrimaryE->size(); i++) {
+      double e = hitPrimaryE->at(i);
+      double theta = hitPrimaryTheta->at(i);
+      double phi = hitPrimaryPhi->at(i);
+      hitTargetWeight[i] = targetDensity(e, theta, phi) /
+                           proposal.proposalDensity(e, theta, phi);
+      if (eventPrimaries.insert(primaryIdx->at(i)).second) {
+        nPrimaries++;
+        sumWeights += hitTargetWeight[i];
+        sumWeights2 += hitTargetWeight[i] * hitTargetWeight[i];
+      }
+    }
+    weights.Fill();
+  }
+  output.cd();
+  weights.Write();
+  output.Close();
+
+  // Kish effective sample size of the primaries with hits
+  std::printf(
+      "Reweighted %llu primaries with hits: sum of weights %.6g, effective "
+      "sample size %.6g (%.2f %%)\n",
+      static_cast<unsigned long long>(nPrimaries), sumWeights,
+      sumWeights * sumWeights / sumWeights2,
+      100.0 * sumWeights * sumWeights / sumWeights2 / nPrimaries);
+  return 0;
+}
@@ -0,0 +1,174 @@
+// Compares the momenta sampled from a MomentumTable with the source
+// file: px, py, pz, |p| and the polar angle, overlaid per variable
+// with the Kolmogorov and chi2 probabilities of the histograms.
+// The table is built first if the cache does not hold it.
+//
+// Usage: alWindowMomentumCheck <momenta.txt> <table.bin> [plot.pdf]
+//                              [nSampled] [nBins]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "MomentumTable.hh"
+#include "TCanvas.h"
+#include "TH1D.h"
+#include "TLegend.h"
+#include "TROOT.h"
+
+namespace {
+
+constexpr int nVariables = 5;
+const char* variableNames[nVariables] = {"px", "py", "pz", "p", "theta"};
+
+/// px, py, pz [m_e c], |p| [m_e c] and the polar angle [rad]
+void variables(const double momentum[3], double values[nVariables]) {
+  double pt = std::hypot(momentum[0], momentum[1]);
+  values[0] = momentum[0];
+  values[1] = momentum[1];
+  values[2] = momentum[2];
+  values[3] = std::hypot(pt, momentum[2]);
+  values[4] = std::atan2(pt, momentum[2]);
+}
+
+/// Reads "px,py,pz" lines and calls fill for each momentum
+template <typename Fill>
+std::uint64_t readMomenta(const std::string& path, Fill fill) {
+  std::ifstream file(path);
+  std::string line;
+  std::uint64_t n = 0;
+  while (std::getline(file, line)) {
+    const char* text = line.c_str();
+    char* end;
+    double momentum[3];
+    bool ok = true;
+    for (int k = 0; k < 3 && ok; k++) {
+      momentum[k] = std::strtod(text, &end);
+      ok = end != text;
+      text = *end == ',' ? end + 1 : end;
+    }
+    if (ok) {
+      fill(momentum);
+      n++;
+    }
+  }
+  return n;
+}
+
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  if (argc < 3) {
+    std::printf(
+        "Usage: %s <momenta.txt> <table.bin> [plot.pdf] [nSampled] "
+        "[nBins]\n",
+        argv[0]);
+    return 1;
+  }
+  std::string sourcePath = argv[1];
+  std::string tablePath = argv[2];
+  std::string plotPath = argc > 3 ? argv[3] : "momentumTable.pdf";
+  std::uint64_t nSampled = argc > 4 ? std::stoull(argv[4]) : 0;
+  int nBins = argc > 5 ? std::stoi(argv[5]) : 200;
+
+  MomentumTable table({.sourcePath = sourcePath, .cachePath = tablePath});
+  if (!table.valid()) {
+    std::fprintf(stderr, "No momenta in %s or %s\n", sourcePath.c_str(),
+                 tablePath.c_str());
+    return 1;
+  }
+
+  // Histogram ranges of the source file
+  double lower[nVariables], upper[nVariables];
+  std::fill(lower, lower + nVariables, 1e300);
+  std::fill(upper, upper + nVariables, -1e300);
+  std::uint64_t nSource = readMomenta(sourcePath, [&](const double* p) {
+    double values[nVariables];
+    variables(p, values);
+    for (int k = 0; k < nVariables; k++) {
+      lower[k] = std::min(lower[k], values[k]);
+      upper[k] = std::max(upper[k], values[k]);
+    }
+  });
+  if (nSource == 0) {
+    std::fprintf(stderr, "No momenta in %s\n", sourcePath.c_str());
+    return 1;
+  }
+  if (nSampled == 0) {
+    nSampled = nSource;
+  }
+
+  std::vector<std::unique_ptr<TH1D>> source, sampled;
+  for (int k = 0; k < nVariables; k++) {
+    double margin = 1e-6 * (upper[k] - lower[k]) + 1e-12;
+    for (auto* histograms : {&source, &sampled}) {
+      std::string name = std::string(variableNames[k]) +
+                         (histograms == &source ? "Source" : "Sampled");
+      histograms->push_back(std::make_unique<TH1D>(
+          name.c_str(), variableNames[k], nBins, lower[k] - margin,
+          upper[k] + margin));
+      histograms->back()->SetDirectory(nullptr);
+      histograms->back()->Sumw2();
+    }
+  }
+
+  readMomenta(sourcePath, [&](const double* p) {
+    double values[nVariables];
+    variables(p, values);
+    for (int k = 0; k < nVariables; k++) {
+      source[k]->Fill(values[k]);
+    }
+  });
+
+  std::mt19937 rng(1);
+  for (std::uint64_t i = 0; i < nSampled; i++) {
+    double momentum[3], values[nVariables];
+    table.sample(rng, momentum);
+    variables(momentum, values);
+    for (int k = 0; k < nVariables; k++) {
+      sampled[k]->Fill(values[k]);
+    }
+  }
+
+  gROOT->SetBatch(true);
+  TCanvas canvas("momentumTable", "momentumTable", 1500, 900);
+  canvas.Divide(3, 2);
+  std::printf("Table: %zu bins of %llu momenta (%s); %llu source, %llu "
+              "sampled\n%-6s %12s %12s %12s %12s\n",
+              table.nBins(), static_cast<unsigned long long>(table.nSamples()),
+              table.fromCache() ? "cached" : "built",
+              static_cast<unsigned long long>(nSource),
+              static_cast<unsigned long long>(nSampled), "var", "mean src",
+              "mean table", "KS prob", "chi2 prob");
+  std::vector<std::unique_ptr<TLegend>> legends;
+  for (int k = 0; k < nVariables; k++) {
+    double ks = source[k]->KolmogorovTest(sampled[k].get());
+    double chi2 = source[k]->Chi2Test(sampled[k].get(), "UU");
+    std::printf("%-6s %12.5g %12.5g %12.4f %12.4f\n", variableNames[k],
+                source[k]->GetMean(), sampled[k]->GetMean(), ks, chi2);
+
+    canvas.cd(k + 1);
+    source[k]->Scale(1.0 / source[k]->Integral());
+    sampled[k]->Scale(1.0 / sampled[k]->Integral());
+    source[k]->SetStats(false);
+    source[k]->SetLineColor(1);
+    sampled[k]->SetLineColor(2);
+    source[k]->SetMaximum(
+        1.2 * std::max(source[k]->GetMaximum(), sampled[k]->GetMaximum()));
+    source[k]->Draw("hist");
+    sampled[k]->Draw("hist same");
+
+    legends.push_back(std::make_unique<TLegend>(0.6, 0.75, 0.88, 0.88));
+    legends.back()->AddEntry(source[k].get(), "file", "l");
+    legends.back()->AddEntry(sampled[k].get(), "table", "l");
+    legends.back()->Draw();
+  }
+  canvas.SaveAs(plotPath.c_str());
+  return 0;
+}